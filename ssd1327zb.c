@@ -32,6 +32,8 @@
 
 #define SSD1327ZB_CMD_SETCOLUMNADDR              0x15
 #define SSD1327ZB_CMD_SETROWADDR                 0x75
+#define SSD1327ZB_CMD_SCROLLSTOP                 0x2E
+#define SSD1327ZB_CMD_SCROLLSTART                0x2F
 #define SSD1327ZB_CMD_SETCONTRAST                0x81
 #define SSD1327ZB_CMD_SEGMENTREMAP               0xA0 /**< Set Display remap */
 #define SSD1327ZB_CMD_STARTLINE                  0xA1 /**< Set start line */
@@ -41,6 +43,14 @@
 #define SSD1327ZB_CMD_DISPLAYINVERSE             0xA7
 #define SSD1327ZB_CMD_DISPLAYOFF                 0xAE
 #define SSD1327ZB_CMD_DISPLAYON                  0xAF
+#define SSD1327ZB_CMD_GRAYTABLE                  0xB8 /**< Set custom gray scale table */
+#define SSD1327ZB_CMD_LINEARGRAYTABLE            0xB9 /**< Select default linear gray scale table */
+
+#define SSD1327ZB_CONTRAST_RESET                 0x7F /**< Contrast after reset */
+
+#define SSD1327ZB_I2C_CONTROL_COMMAND            0x00 /**< Control byte: only command bytes follow */
+#define SSD1327ZB_I2C_CONTROL_DATA               0x40 /**< Control byte: only data bytes follow */
+#define SSD1327ZB_I2C_CONTROL_NEXT_COMMAND       0x80 /**< Control byte: one command byte, then another control byte */
 
 #define SSD1327ZB_REMAP_COLUMN                   0x01 /**< Enable column address remap */
 #define SSD1327ZB_REMAP_NIBBLE                   0x02 /**< Enable nibble remap */
@@ -48,6 +58,27 @@
 #define SSD1327ZB_REMAP_COM                      0x10 /**< Enable COM remap */
 #define SSD1327ZB_REMAP_ODDEVEN_COM              0x40 /**< Enable COM split odd/even */
 
+/**
+ * Number of bytes spent on the bus to open a new window into the display
+ * memory: three command bytes for columns and three for rows.
+ */
+#define SSD1327ZB_WINDOW_COST                    6
+
+#define SSD1327ZB_MEMORY_WIDTH                   128 /**< Columns of the display memory */
+#define SSD1327ZB_MEMORY_HEIGHT                  128 /**< Rows of the display memory */
+
+#if defined WARCOMEB_SSD1327ZB_STATS
+#define SSD1327ZB_STATS_ADD(counter,value)       (dev->stats.counter += (value))
+#define SSD1327ZB_STATS_BEGIN()                  uint32_t statsStart = SSD1327ZB_getStatsTime(dev)
+#define SSD1327ZB_STATS_END(counter)             SSD1327ZB_addFlushStats(dev,&dev->stats.counter,statsStart)
+#define SSD1327ZB_STATS_PIXEL(xPos,yPos,color)   SSD1327ZB_addPixelStats(dev,xPos,yPos,color)
+#else
+#define SSD1327ZB_STATS_ADD(counter,value)       do {} while (0)
+#define SSD1327ZB_STATS_BEGIN()                  do {} while (0)
+#define SSD1327ZB_STATS_END(counter)             do {} while (0)
+#define SSD1327ZB_STATS_PIXEL(xPos,yPos,color)   do {} while (0)
+#endif
+
 #define SSD1327ZB_write(value) do {                                         \
     ((value & 0x01) > 0) ? Gpio_set(dev->gdl.d0) : Gpio_clear(dev->gdl.d0); \
     ((value & 0x02) > 0) ? Gpio_set(dev->gdl.d1) : Gpio_clear(dev->gdl.d1); \
@@ -59,52 +90,313 @@
     ((value & 0x80) > 0) ? Gpio_set(dev->gdl.d7) : Gpio_clear(dev->gdl.d7); \
     } while (0)
 
-static void SSD1327ZB_sendCommand (SSD1327ZB_Device* dev, uint8_t command)
+#if defined WARCOMEB_GDL_PARALLEL && defined WARCOMEB_SSD1327ZB_FAST_PORT
+/**
+ * The function check if all the data lines are into the same port and, in this
+ * case, compute the set mask for every value of the two nibbles of a byte.
+ * Otherwise the data lines are written one by one.
+ *
+ * @param[in] dev The handle of the device
+ */
+static void SSD1327ZB_configPort (SSD1327ZB_Device* dev)
 {
-#if defined WARCOMEB_GDL_PARALLEL
+    const Gpio_Pins pins[8] =
+    {
+        dev->gdl.d0, dev->gdl.d1, dev->gdl.d2, dev->gdl.d3,
+        dev->gdl.d4, dev->gdl.d5, dev->gdl.d6, dev->gdl.d7,
+    };
+    volatile uint32_t* setRegister;
+    volatile uint32_t* clearRegister;
+    uint32_t bitMask[8];
+    uint8_t bit;
+
+    // Default: the slow path
+    dev->portSet = 0;
+    dev->portClear = 0;
+    dev->portDataMask = 0;
+
+    if (dev->portMapper == 0) return;
+
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        bool isMapped = dev->portMapper(pins[i],&setRegister,&clearRegister,&bit);
+
+        if (!isMapped || ((i > 0) && ((setRegister != dev->portSet) || (clearRegister != dev->portClear))))
+        {
+            // A line is unknown or the lines are spread on different ports
+            dev->portSet = 0;
+            dev->portClear = 0;
+            dev->portDataMask = 0;
+            return;
+        }
+
+        dev->portSet = setRegister;
+        dev->portClear = clearRegister;
+        bitMask[i] = (uint32_t)1 << bit;
+        dev->portDataMask |= bitMask[i];
+    }
+
+    for (uint8_t value = 0; value < 16; ++value)
+    {
+        uint32_t low = 0, high = 0;
+        for (uint8_t i = 0; i < 4; ++i)
+        {
+            if (value & (1 << i))
+            {
+                low |= bitMask[i];
+                high |= bitMask[i + 4];
+            }
+        }
+        dev->portLowMask[value] = low;
+        dev->portHighMask[value] = high;
+    }
+}
+#endif
+
+/**
+ * The function select the device and prepare the bus for a transfer.
+ * The device stay selected until SSD1327ZB_endTransfer is called, so
+ * a whole block of bytes can be sent strobing only the write line.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] isData TRUE for a data transfer, FALSE for a command transfer
+ */
+static void SSD1327ZB_beginTransfer (SSD1327ZB_Device* dev, bool isData)
+{
+#if defined WARCOMEB_SSD1327ZB_EMULATOR
+
+    if (!dev->isSelected)
+        SSD1327ZB_emulatorTransaction(dev->emulator);
+    dev->isDataTransfer = isData;
+
+#elif defined WARCOMEB_GDL_PARALLEL
+
+    if (!dev->isSelected)
+    {
+        Gpio_set(dev->gdl.rd);
+        Gpio_clear(dev->gdl.cs);
+        Gpio_set(dev->gdl.wr);
+    }
+    // Select command or data message
+    (isData) ? Gpio_set(dev->gdl.dc) : Gpio_clear(dev->gdl.dc);
+
+#elif defined WARCOMEB_GDL_I2C
+
+    if (dev->isSelected)
+    {
+        // Into a held transfer the data run until the stop condition, so
+        // the commands after the data need a new transaction
+        if (dev->isDataTransfer == isData) return;
+        if (dev->isDataTransfer)
+        {
+            Iic_stop(dev->iicDev);
+            Iic_start(dev->iicDev);
+            Iic_writeByte(dev->iicDev,(dev->address << 1));
+        }
+        // The commands are sent one by one with the continuation bit
+        if (isData)
+            Iic_writeByte(dev->iicDev,SSD1327ZB_I2C_CONTROL_DATA);
+        dev->isDataTransfer = isData;
+        return;
+    }
+
+    Iic_start(dev->iicDev);
+    Iic_writeByte(dev->iicDev,(dev->address << 1));
+    // Continuation bit cleared: all the next bytes are of the same type
+    Iic_writeByte(dev->iicDev,
+                  (isData) ? SSD1327ZB_I2C_CONTROL_DATA : SSD1327ZB_I2C_CONTROL_COMMAND);
+
+#elif defined WARCOMEB_GDL_SPI
+
+    if (!dev->isSelected)
+        Gpio_clear(dev->csPin);
+    // Select command or data message
+    (isData) ? Gpio_set(dev->dcPin) : Gpio_clear(dev->dcPin);
+
+#endif
+}
+
+/**
+ * The function send one byte into a transfer opened with
+ * SSD1327ZB_beginTransfer.
+ */
+static inline void SSD1327ZB_transferByte (SSD1327ZB_Device* dev, uint8_t value)
+{
+#if defined WARCOMEB_SSD1327ZB_EMULATOR
+
+    if (dev->isDataTransfer)
+        SSD1327ZB_emulatorData(dev->emulator,value);
+    else
+        SSD1327ZB_emulatorCommand(dev->emulator,value);
+
+#elif defined WARCOMEB_GDL_PARALLEL
 
-    Gpio_set(dev->gdl.rd);
-    Gpio_clear(dev->gdl.cs);
-    Gpio_set(dev->gdl.wr);
-    // Is command message
-    Gpio_clear(dev->gdl.dc);
     // Enable writing
     Gpio_clear(dev->gdl.wr);
-    SSD1327ZB_write(command);
+#if defined WARCOMEB_SSD1327ZB_FAST_PORT
+    if (dev->portSet != 0)
+    {
+        uint32_t mask = dev->portLowMask[value & 0x0F] | dev->portHighMask[value >> 4];
+        *dev->portSet = mask;
+        *dev->portClear = dev->portDataMask & ~mask;
+    }
+    else
+#endif
+    SSD1327ZB_write(value);
     // Restore write pin
     Gpio_set(dev->gdl.wr);
+
+#elif defined WARCOMEB_GDL_I2C
+
+    if (dev->isSelected && !dev->isDataTransfer)
+        Iic_writeByte(dev->iicDev,SSD1327ZB_I2C_CONTROL_NEXT_COMMAND);
+    Iic_writeByte(dev->iicDev,value);
+
+#elif defined WARCOMEB_GDL_SPI
+
+    Spi_writeByte(dev->spiDev,value);
+
+#endif
+}
+
+/**
+ * The function close the current transfer and release the device.
+ */
+static void SSD1327ZB_endTransfer (SSD1327ZB_Device* dev)
+{
+#if defined WARCOMEB_SSD1327ZB_EMULATOR
+
+    (void) dev;
+
+#elif defined WARCOMEB_GDL_PARALLEL
+
     // Disable device
-    Gpio_set(dev->gdl.cs);
+    if (!dev->isSelected)
+        Gpio_set(dev->gdl.cs);
 
 #elif defined WARCOMEB_GDL_I2C
 
+    if (!dev->isSelected)
+        Iic_stop(dev->iicDev);
+
 #elif defined WARCOMEB_GDL_SPI
 
+    if (!dev->isSelected)
+        Gpio_set(dev->csPin);
+
 #endif
 }
 
-static void SSD1327ZB_sendData (SSD1327ZB_Device* dev, uint8_t value)
+/**
+ * The function keep the display selected until SSD1327ZB_releaseDevice is
+ * called: the transfers between them change only the data/command line.
+ * On I2C the commands are sent with the continuation bit and the data run
+ * until the stop condition, so only commands after data need a new
+ * transaction.
+ * Nothing change if the display is already selected.
+ *
+ * @param[in] dev The handle of the device
+ */
+static void SSD1327ZB_selectDevice (SSD1327ZB_Device* dev)
 {
-#if defined WARCOMEB_GDL_PARALLEL
+    if (dev->isSelected) return;
+
+#if defined WARCOMEB_SSD1327ZB_EMULATOR
+
+    SSD1327ZB_emulatorTransaction(dev->emulator);
+    dev->isSelected = TRUE;
+
+#elif defined WARCOMEB_GDL_PARALLEL
 
     Gpio_set(dev->gdl.rd);
     Gpio_clear(dev->gdl.cs);
     Gpio_set(dev->gdl.wr);
-    // is data message
-    Gpio_set(dev->gdl.dc);
-    // Enable writing
-    Gpio_clear(dev->gdl.wr);
-    SSD1327ZB_write(value);
-    // Restore write pin
-    Gpio_set(dev->gdl.wr);
-    // Disable device
-    Gpio_set(dev->gdl.cs);
+    dev->isSelected = TRUE;
 
 #elif defined WARCOMEB_GDL_I2C
 
+    Iic_start(dev->iicDev);
+    Iic_writeByte(dev->iicDev,(dev->address << 1));
+    dev->isDataTransfer = FALSE;
+    dev->isSelected = TRUE;
+
+#elif defined WARCOMEB_GDL_SPI
+
+    Gpio_clear(dev->csPin);
+    dev->isSelected = TRUE;
+
+#endif
+}
+
+/**
+ * The function release the display selected by SSD1327ZB_selectDevice.
+ *
+ * @param[in] dev The handle of the device
+ */
+static void SSD1327ZB_releaseDevice (SSD1327ZB_Device* dev)
+{
+    if (!dev->isSelected) return;
+    dev->isSelected = FALSE;
+
+#if defined WARCOMEB_SSD1327ZB_EMULATOR
+    (void) dev;
+#elif defined WARCOMEB_GDL_PARALLEL
+    Gpio_set(dev->gdl.cs);
+#elif defined WARCOMEB_GDL_I2C
+    Iic_stop(dev->iicDev);
 #elif defined WARCOMEB_GDL_SPI
+    Gpio_set(dev->csPin);
+#endif
+}
+
+/**
+ * The function send a list of commands (with their arguments) into a
+ * single transfer.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] commands The list of command bytes
+ * @param[in] length The number of bytes into the list
+ */
+static void SSD1327ZB_sendCommandList (SSD1327ZB_Device* dev,
+                                       const uint8_t* commands,
+                                       uint16_t length)
+{
+    SSD1327ZB_STATS_ADD(commandBytes,length);
+
+    SSD1327ZB_beginTransfer(dev,FALSE);
+    for (uint16_t i = 0; i < length; ++i)
+    {
+        SSD1327ZB_transferByte(dev,commands[i]);
+    }
+    SSD1327ZB_endTransfer(dev);
+}
+
+#if !defined WARCOMEB_SSD1327ZB_BANDED
+/**
+ * The function send a block of display data into a single transfer.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] data The data to be sent
+ * @param[in] length The number of bytes to be sent
+ */
+static void SSD1327ZB_sendDataBlock (SSD1327ZB_Device* dev,
+                                     const uint8_t* data,
+                                     uint16_t length)
+{
+    SSD1327ZB_STATS_ADD(dataBytes,length);
 
+    SSD1327ZB_beginTransfer(dev,TRUE);
+    for (uint16_t i = 0; i < length; ++i)
+    {
+        SSD1327ZB_transferByte(dev,data[i]);
+    }
+    SSD1327ZB_endTransfer(dev);
+}
 #endif
+
+static void SSD1327ZB_sendCommand (SSD1327ZB_Device* dev, uint8_t command)
+{
+    SSD1327ZB_sendCommandList(dev,&command,1);
 }
 
 /**
@@ -131,215 +423,2796 @@ static GDL_Errors SSD1327ZB_setBufferPosition (SSD1327ZB_Device* dev,
     if ((xStop >= dev->gdl.width) || (yStop >= dev->gdl.height))
         return GDL_ERRORS_WRONG_POSITION;
 
-    // Set column address
-    SSD1327ZB_sendCommand(dev,SSD1327ZB_CMD_SETCOLUMNADDR);
-    SSD1327ZB_sendCommand(dev,xStart/2);
-    SSD1327ZB_sendCommand(dev,xStop/2);
+    // The display can be wired to a part of the display memory
+    xStart += dev->xOffset;
+    xStop += dev->xOffset;
+    yStart += dev->yOffset;
+    yStop += dev->yOffset;
+
+    uint8_t commands[SSD1327ZB_WINDOW_COST] =
+    {
+        // Set column address
+        SSD1327ZB_CMD_SETCOLUMNADDR, xStart/2, xStop/2,
+        // Set row address
+        SSD1327ZB_CMD_SETROWADDR, yStart, yStop,
+    };
+    SSD1327ZB_sendCommandList(dev,commands,SSD1327ZB_WINDOW_COST);
 
-    // Set row address
-    SSD1327ZB_sendCommand(dev,SSD1327ZB_CMD_SETROWADDR);
-    SSD1327ZB_sendCommand(dev,yStart);
-    SSD1327ZB_sendCommand(dev,yStop);
+    // An incremental flush must open its window again
+    dev->isFlushWindowOpen = FALSE;
 
     return GDL_ERRORS_OK;
 }
 
-void SSD1327ZB_init (SSD1327ZB_Device* dev)
+/**
+ * The function return the number of bytes needed to send an area to the
+ * display, command bytes included.
+ */
+static uint16_t SSD1327ZB_areaCost (const SSD1327ZB_Area* area)
 {
-    // Set the device model
-    dev->gdl.model = GDL_MODELTYPE_SSD1327ZB;
-
-    // Save display size
-    dev->gdl.height = WARCOMEB_SSD1327ZB_HEIGHT;
-    dev->gdl.width = WARCOMEB_SSD1327ZB_WIDTH;
+    uint16_t columns = (area->xStop/2) - (area->xStart/2) + 1;
+    uint16_t rows = area->yStop - area->yStart + 1;
+    return SSD1327ZB_WINDOW_COST + (columns * rows);
+}
 
-    // Save default font size
-    dev->gdl.fontSize = 1;
-    dev->gdl.useCustomFont = FALSE;
+static void SSD1327ZB_areaUnion (SSD1327ZB_Area* result,
+                                 const SSD1327ZB_Area* a,
+                                 const SSD1327ZB_Area* b)
+{
+    result->xStart = (a->xStart < b->xStart) ? a->xStart : b->xStart;
+    result->xStop  = (a->xStop  > b->xStop)  ? a->xStop  : b->xStop;
+    result->yStart = (a->yStart < b->yStart) ? a->yStart : b->yStart;
+    result->yStop  = (a->yStop  > b->yStop)  ? a->yStop  : b->yStop;
+}
 
-    // Save callback for drawing pixel
-    dev->gdl.drawPixel = SSD1327ZB_drawPixel;
+/**
+ * The function reset the bounding box used to track the pixels drawn by
+ * GDL primitives.
+ */
+static void SSD1327ZB_beginDraw (SSD1327ZB_Device* dev)
+{
+    dev->drawBox.xStart = 0xFF;
+    dev->drawBox.xStop  = 0;
+    dev->drawBox.yStart = 0xFF;
+    dev->drawBox.yStop  = 0;
+}
 
-//    memset(dev->buffer, 0x00, WARCOMEB_SSD1327ZB_BUFFERDIMENSION);
+/**
+ * The function add to the dirty list the bounding box of the pixels drawn
+ * since the last call of SSD1327ZB_beginDraw.
+ */
+static void SSD1327ZB_endDraw (SSD1327ZB_Device* dev)
+{
+    if (dev->drawBox.xStart > dev->drawBox.xStop) return;
 
-#if defined WARCOMEB_GDL_PARALLEL
+    SSD1327ZB_markDirty(dev,
+                        dev->drawBox.xStart,
+                        dev->drawBox.xStop,
+                        dev->drawBox.yStart,
+                        dev->drawBox.yStop);
+}
 
-    Gpio_config(dev->gdl.d0,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d1,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d2,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d3,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d4,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d5,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d6,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d7,GPIO_PINS_OUTPUT);
+/**
+ * The function return the number of bytes of the whole display.
+ */
+static inline uint16_t SSD1327ZB_getFrameSize (SSD1327ZB_Device* dev)
+{
+    return (uint16_t) dev->gdl.height * (dev->gdl.width/2);
+}
 
-    Gpio_config(dev->gdl.rd,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.dc,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.rs,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.cs,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.wr,GPIO_PINS_OUTPUT);
+/**
+ * The function return the first byte of a row of the buffer, addressed by
+ * its position into the display memory.
+ */
+static inline uint8_t* SSD1327ZB_getBufferRow (SSD1327ZB_Device* dev, uint8_t row)
+{
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    row -= dev->bandStart;
+#endif
+    return &dev->buffer[(uint16_t) row*(dev->gdl.width/2)];
+}
 
-    Gpio_set(dev->gdl.dc);
-    Gpio_set(dev->gdl.rd);
-    Gpio_set(dev->gdl.wr);
-    Gpio_set(dev->gdl.cs);
-    Gpio_set(dev->gdl.rs);
+/**
+ * The function return the first byte of a row of the buffer.
+ */
+static inline uint8_t* SSD1327ZB_getRow (SSD1327ZB_Device* dev, uint8_t yPos)
+{
+#if defined WARCOMEB_SSD1327ZB_SCROLL
+    // The buffer is a ring of rows, moved by the scroll offset
+    uint16_t row = (uint16_t) yPos + dev->scrollOffset;
+    if (row >= dev->gdl.height) row -= dev->gdl.height;
+    return &dev->buffer[row*(dev->gdl.width/2)];
+#else
+    return SSD1327ZB_getBufferRow(dev,yPos);
+#endif
+}
 
-#elif defined WARCOMEB_GDL_I2C
+/**
+ * The function clip a range of rows to the rows held by the buffer.
+ *
+ * @return FALSE if no row is held by the buffer.
+ */
+static inline bool SSD1327ZB_clipRows (SSD1327ZB_Device* dev,
+                                       uint8_t* yStart,
+                                       uint8_t* yStop)
+{
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    const uint16_t bandStop = dev->bandStart + dev->bandRows - 1;
 
-#elif defined WARCOMEB_GDL_SPI
+    if ((*yStop < dev->bandStart) || (*yStart > bandStop))
+        return FALSE;
 
+    if (*yStart < dev->bandStart) *yStart = dev->bandStart;
+    if (*yStop > bandStop) *yStop = bandStop;
+#else
+    (void) dev;
+    (void) yStart;
+    (void) yStop;
 #endif
+    return TRUE;
+}
 
-    SSD1327ZB_sendCommand(dev,SSD1327ZB_CMD_DISPLAYON);
-    // Wait 100ms after on
-    dev->gdl.delayTime(100);
+/**
+ * @return TRUE if the row is held by the buffer.
+ */
+static inline bool SSD1327ZB_isRowInBuffer (SSD1327ZB_Device* dev, uint8_t yPos)
+{
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    return ((yPos >= dev->bandStart) && (yPos < (dev->bandStart + dev->bandRows))) ? TRUE : FALSE;
+#else
+    (void) dev;
+    (void) yPos;
+    return TRUE;
+#endif
+}
 
-    // Set display to normal
-    SSD1327ZB_sendCommand(dev,SSD1327ZB_CMD_DISPLAYNORMAL);
+#if defined WARCOMEB_SSD1327ZB_BANDED
+/**
+ * The function select the band of rows held by the buffer. An active
+ * incremental flush is dropped, because its rows are no more into the
+ * buffer.
+ */
+static void SSD1327ZB_setBand (SSD1327ZB_Device* dev, uint8_t start)
+{
+    dev->bandStart = start;
 
-    // Select segment re-map, COM scan direction, COM hardware configuration and
-    // de-select level
-    // They depend on producer choice
-    switch (dev->gdl.product)
-    {
-    case SSD1327ZB_PRODUCT_RAYSTAR_REX128128B:
-        SSD1327ZB_sendCommand(dev,SSD1327ZB_CMD_SEGMENTREMAP);
-        SSD1327ZB_sendCommand(dev,SSD1327ZB_REMAP_ODDEVEN_COM);
+    dev->flushQueueCount = 0;
+    dev->flushArea = 0;
+    dev->isFlushWindowOpen = FALSE;
+}
 
-        SSD1327ZB_sendCommand(dev,SSD1327ZB_CMD_STARTLINE);
-        SSD1327ZB_sendCommand(dev,0);
-        break;
-    }
+/**
+ * @return The last row of the current band, into the display.
+ */
+static inline uint8_t SSD1327ZB_getBandStop (SSD1327ZB_Device* dev)
+{
+    uint16_t bandStop = dev->bandStart + dev->bandRows - 1;
+    return (bandStop >= dev->gdl.height) ? (dev->gdl.height - 1) : bandStop;
 }
+#endif
 
-GDL_Errors SSD1327ZB_drawPixel (SSD1327ZB_Device* dev,
-                                uint8_t xPos,
-                                uint8_t yPos,
-							    SSD1327ZB_GrayScale color)
+/**
+ * The function move a pointer into the buffer by a number of rows,
+ * following the ring of rows when the scroll is enabled.
+ */
+static inline uint8_t* SSD1327ZB_moveRows (SSD1327ZB_Device* dev,
+                                           uint8_t* pixel,
+                                           int16_t offset)
 {
-    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
-        return GDL_ERRORS_WRONG_POSITION;
+    pixel += offset;
+#if defined WARCOMEB_SSD1327ZB_SCROLL
+    if (pixel >= &dev->buffer[WARCOMEB_SSD1327ZB_BUFFERDIMENSION])
+        pixel -= WARCOMEB_SSD1327ZB_BUFFERDIMENSION;
+    else if (pixel < dev->buffer)
+        pixel += WARCOMEB_SSD1327ZB_BUFFERDIMENSION;
+#else
+    (void) dev;
+#endif
+    return pixel;
+}
 
-    uint16_t pos = ((uint16_t) xPos/2) + ((uint16_t) yPos*(dev->gdl.width/2));
+/**
+ * The function write a pixel into the buffer without any check.
+ */
+static inline void SSD1327ZB_putPixel (SSD1327ZB_Device* dev,
+                                       uint8_t xPos,
+                                       uint8_t yPos,
+                                       uint8_t color)
+{
+    uint8_t* pixel = SSD1327ZB_getRow(dev,yPos) + (xPos/2);
 
     if (xPos%2)
-        dev->buffer[pos] = (((color << 4) & 0xF0) | (dev->buffer[pos] & 0x0F));
+        *pixel = (((color << 4) & 0xF0) | (*pixel & 0x0F));
     else
-        dev->buffer[pos] = ((color & 0x0F) | (dev->buffer[pos] & 0xF0));
-
-    return GDL_ERRORS_OK;
+        *pixel = ((color & 0x0F) | (*pixel & 0xF0));
 }
 
-void SSD1327ZB_setContrast (SSD1327ZB_Device* dev, uint8_t value)
+#if defined WARCOMEB_SSD1327ZB_STATS
+
+static uint32_t SSD1327ZB_getStatsTime (SSD1327ZB_Device* dev)
 {
-    SSD1327ZB_sendCommand(dev,SSD1327ZB_CMD_SETCONTRAST);
-    SSD1327ZB_sendCommand(dev,value);
+    return (dev->getTime != 0) ? dev->getTime() : 0;
 }
 
-void SSD1327ZB_flush (SSD1327ZB_Device* dev)
+/**
+ * The function count a flush and add its duration to the time counters.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] counter The counter of the kind of flush
+ * @param[in] start The time at the start of the flush
+ */
+static void SSD1327ZB_addFlushStats (SSD1327ZB_Device* dev,
+                                     uint32_t* counter,
+                                     uint32_t start)
 {
+    (*counter)++;
+
+    // The unsigned difference is right also when the clock wraps around
+    uint32_t duration = SSD1327ZB_getStatsTime(dev) - start;
+    dev->stats.flushTime += duration;
+    if (duration > dev->stats.flushTimeMax)
+        dev->stats.flushTimeMax = duration;
+}
+
+/**
+ * The function count a pixel written one by one, before it is written.
+ */
+static void SSD1327ZB_addPixelStats (SSD1327ZB_Device* dev,
+                                     uint8_t xPos,
+                                     uint8_t yPos,
+                                     uint8_t color)
+{
+    dev->stats.pixels++;
+
+    if (!SSD1327ZB_isRowInBuffer(dev,yPos)) return;
+
+    uint8_t value = SSD1327ZB_getRow(dev,yPos)[xPos/2];
+    value = (xPos%2) ? (value >> 4) : (value & 0x0F);
+    if (value == (color & 0x0F))
+        dev->stats.redundantPixels++;
+}
+
+void SSD1327ZB_resetStats (SSD1327ZB_Device* dev)
+{
+    memset(&dev->stats,0,sizeof(SSD1327ZB_Stats));
+}
+
+void SSD1327ZB_getStats (SSD1327ZB_Device* dev, SSD1327ZB_Stats* stats)
+{
+    memcpy(stats,&dev->stats,sizeof(SSD1327ZB_Stats));
+}
+
+#endif
+
+/**
+ * The function fill the pixels from xStart to xStop (inclusive) of a row.
+ * Only the edges are written nibble by nibble, the inner part is written
+ * two pixels per byte.
+ */
+static void SSD1327ZB_fillSpan (uint8_t* row,
+                                uint8_t xStart,
+                                uint8_t xStop,
+                                uint8_t color)
+{
+    color &= 0x0F;
+
+    if (xStart%2)
+    {
+        // The first pixel is the high nibble of its byte
+        row[xStart/2] = (color << 4) | (row[xStart/2] & 0x0F);
+        if (xStart == xStop) return;
+        xStart++;
+    }
+
+    if ((xStop%2) == 0)
+    {
+        // The last pixel is the low nibble of its byte
+        row[xStop/2] = color | (row[xStop/2] & 0xF0);
+        if (xStop == xStart) return;
+        xStop--;
+    }
+
+    // Now the span is made of whole bytes
+    memset(&row[xStart/2],(color << 4) | color,(xStop - xStart + 1)/2);
+}
+
+/**
+ * The function fill an area of the buffer, the bounds must be already
+ * clipped to the display.
+ */
+static void SSD1327ZB_fillArea (SSD1327ZB_Device* dev,
+                                uint8_t xStart,
+                                uint8_t xStop,
+                                uint8_t yStart,
+                                uint8_t yStop,
+                                uint8_t color)
+{
+    if (!SSD1327ZB_clipRows(dev,&yStart,&yStop)) return;
+
+    if ((xStart == 0) && (xStop == (dev->gdl.width - 1)))
+    {
+        // Whole rows are contiguous into the buffer
+        color &= 0x0F;
+        uint8_t* start = SSD1327ZB_getRow(dev,yStart);
+        uint16_t length = (uint16_t)(yStop - yStart + 1) * (dev->gdl.width/2);
+#if defined WARCOMEB_SSD1327ZB_SCROLL
+        // Until the end of the ring of rows
+        uint16_t available = &dev->buffer[WARCOMEB_SSD1327ZB_BUFFERDIMENSION] - start;
+        if (length > available)
+        {
+            memset(dev->buffer,(color << 4) | color,length - available);
+            length = available;
+        }
+#endif
+        memset(start,(color << 4) | color,length);
+        return;
+    }
+
+    for (uint8_t y = yStart; y <= yStop; ++y)
+    {
+        SSD1327ZB_fillSpan(SSD1327ZB_getRow(dev,y),xStart,xStop,color);
+    }
+}
+
+/**
+ * Callback used by GDL primitives: it draw the pixel and update the
+ * bounding box of the current primitive, the area is marked dirty only
+ * once at the end of the primitive.
+ */
+static GDL_Errors SSD1327ZB_drawPixelCallback (SSD1327ZB_Device* dev,
+                                               uint8_t xPos,
+                                               uint8_t yPos,
+                                               SSD1327ZB_GrayScale color)
+{
+    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    SSD1327ZB_STATS_PIXEL(xPos,yPos,color);
+    if (SSD1327ZB_isRowInBuffer(dev,yPos))
+        SSD1327ZB_putPixel(dev,xPos,yPos,color);
+
+    if (xPos < dev->drawBox.xStart) dev->drawBox.xStart = xPos;
+    if (xPos > dev->drawBox.xStop)  dev->drawBox.xStop  = xPos;
+    if (yPos < dev->drawBox.yStart) dev->drawBox.yStart = yPos;
+    if (yPos > dev->drawBox.yStop)  dev->drawBox.yStop  = yPos;
+
+    return GDL_ERRORS_OK;
+}
+
+/**
+ * The function copy a run of nibble-packed pixels. Source and destination
+ * are addressed by pixel, when they have the same parity the run is copied
+ * byte by byte, otherwise every byte is built shifting by one nibble.
+ *
+ * @param[out] dst The destination row
+ * @param[in] dstX The first destination pixel
+ * @param[in] src The source row
+ * @param[in] srcX The first source pixel
+ * @param[in] count The number of pixels to copy
+ */
+static void SSD1327ZB_copyNibbles (uint8_t* dst,
+                                   uint16_t dstX,
+                                   const uint8_t* src,
+                                   uint16_t srcX,
+                                   uint16_t count)
+{
+    if (count == 0) return;
+
+    dst += dstX/2;
+    src += srcX/2;
+
+    if ((dstX%2) == (srcX%2))
+    {
+        if (dstX%2)
+        {
+            *dst = (*src & 0xF0) | (*dst & 0x0F);
+            dst++;
+            src++;
+            count--;
+        }
+        memcpy(dst,src,count/2);
+        if (count%2)
+            dst[count/2] = (src[count/2] & 0x0F) | (dst[count/2] & 0xF0);
+        return;
+    }
+
+    if (dstX%2)
+    {
+        // Now the source is at the high nibble of its byte
+        *dst = (uint8_t)(*src << 4) | (*dst & 0x0F);
+        dst++;
+        count--;
+    }
+
+    for (; count >= 2; count -= 2, src++)
+    {
+        *dst++ = (src[0] >> 4) | (uint8_t)(src[1] << 4);
+    }
+    if (count)
+        *dst = (src[0] >> 4) | (*dst & 0xF0);
+}
+
+void SSD1327ZB_markDirty (SSD1327ZB_Device* dev,
+                          uint16_t xStart,
+                          uint16_t xStop,
+                          uint16_t yStart,
+                          uint16_t yStop)
+{
+    if ((xStart > xStop) || (yStart > yStop)) return;
+    if ((xStart >= dev->gdl.width) || (yStart >= dev->gdl.height)) return;
+
+    if (xStop >= dev->gdl.width)  xStop = dev->gdl.width - 1;
+    if (yStop >= dev->gdl.height) yStop = dev->gdl.height - 1;
+
+    // Round to whole column pairs
+    SSD1327ZB_Area area =
+    {
+        .xStart = xStart & 0xFE,
+        .xStop  = xStop | 0x01,
+        .yStart = yStart,
+        .yStop  = yStop,
+    };
+    SSD1327ZB_Area merged;
+
+    uint8_t i = 0;
+    while (i < dev->dirtyCount)
+    {
+        // Merge when a single window costs less than two windows
+        SSD1327ZB_areaUnion(&merged,&area,&dev->dirty[i]);
+        if (SSD1327ZB_areaCost(&merged) <=
+            (SSD1327ZB_areaCost(&area) + SSD1327ZB_areaCost(&dev->dirty[i])))
+        {
+            area = merged;
+            // Remove the old area and restart, the bigger one can now
+            // be merged with other areas
+            dev->dirty[i] = dev->dirty[--dev->dirtyCount];
+            i = 0;
+            continue;
+        }
+        i++;
+    }
+
+    if (dev->dirtyCount == WARCOMEB_SSD1327ZB_DIRTY_AREAS)
+    {
+        // The list is full: merge with the area that grow less
+        uint8_t best = 0;
+        uint16_t bestCost = 0xFFFF;
+        for (i = 0; i < dev->dirtyCount; ++i)
+        {
+            SSD1327ZB_areaUnion(&merged,&area,&dev->dirty[i]);
+            uint16_t cost = SSD1327ZB_areaCost(&merged) - SSD1327ZB_areaCost(&dev->dirty[i]);
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                best = i;
+            }
+        }
+        SSD1327ZB_areaUnion(&dev->dirty[best],&area,&dev->dirty[best]);
+        return;
+    }
+
+    dev->dirty[dev->dirtyCount++] = area;
+}
+
+void SSD1327ZB_flushDirty (SSD1327ZB_Device* dev)
+{
+    for (uint8_t i = 0; i < dev->dirtyCount; ++i)
+    {
+        SSD1327ZB_flushPart(dev,
+                            dev->dirty[i].xStart,
+                            dev->dirty[i].xStop,
+                            dev->dirty[i].yStart,
+                            dev->dirty[i].yStop);
+    }
+    dev->dirtyCount = 0;
+}
+
+/**
+ * The function write the pulse widths of the default linear gray scale
+ * table, from GS1 to GS15.
+ */
+static void SSD1327ZB_getLinearGrayTable (uint8_t* table)
+{
+    for (uint8_t i = 0; i < SSD1327ZB_GRAYTABLE_SIZE; ++i)
+    {
+        table[i] = (i + 1) * 2;
+    }
+}
+
+GDL_Errors SSD1327ZB_init (SSD1327ZB_Device* dev)
+{
+    // Set the device model
+    dev->gdl.model = GDL_MODELTYPE_SSD1327ZB;
+
+    // Save display size
+#if defined WARCOMEB_SSD1327ZB_MULTI
+    // Set by the user, the biggest display is the default
+    if (dev->gdl.height == 0) dev->gdl.height = WARCOMEB_SSD1327ZB_HEIGHT;
+    if (dev->gdl.width == 0) dev->gdl.width = WARCOMEB_SSD1327ZB_WIDTH;
+    // Every row is made of whole bytes
+    dev->gdl.width &= 0xFFFE;
+
+    if ((dev->gdl.height > WARCOMEB_SSD1327ZB_HEIGHT) ||
+        (dev->gdl.width > WARCOMEB_SSD1327ZB_WIDTH) ||
+        (dev->gdl.width == 0))
+        return GDL_ERRORS_WRONG_VALUE;
+#if !defined WARCOMEB_SSD1327ZB_EXTERNAL_BUFFER
+    // The user buffer must hold the whole display
+    if ((dev->buffer == 0) || (dev->bufferSize < SSD1327ZB_getFrameSize(dev)))
+        return GDL_ERRORS_WRONG_VALUE;
+#endif
+#else
+    dev->gdl.height = WARCOMEB_SSD1327ZB_HEIGHT;
+    dev->gdl.width = WARCOMEB_SSD1327ZB_WIDTH;
+    dev->xOffset = WARCOMEB_SSD1327ZB_X_OFFSET;
+    dev->yOffset = WARCOMEB_SSD1327ZB_Y_OFFSET;
+#endif
+
+    // The display must fit into the display memory, from a whole byte
+    dev->xOffset &= 0xFE;
+    if (((dev->xOffset + dev->gdl.width) > SSD1327ZB_MEMORY_WIDTH) ||
+        ((dev->yOffset + dev->gdl.height) > SSD1327ZB_MEMORY_HEIGHT))
+        return GDL_ERRORS_WRONG_VALUE;
+
+    // Save default font size
+    dev->gdl.fontSize = 1;
+    dev->gdl.useCustomFont = FALSE;
+
+    // Save callback for drawing pixel
+    dev->gdl.drawPixel = SSD1327ZB_drawPixelCallback;
+
+    // Nothing to send yet
+    dev->isSelected = FALSE;
+    dev->dirtyCount = 0;
+    dev->flushQueueCount = 0;
+    dev->flushArea = 0;
+
+    // No limit to the frames of the scheduler
+    dev->frameInterval = 0;
+    dev->frameBudget = 0;
+    dev->frameStart = 0;
+
+#if defined WARCOMEB_SSD1327ZB_GLYPH_CACHE_SIZE
+    SSD1327ZB_clearGlyphCache(dev);
+#endif
+
+    SSD1327ZB_setPictureColors(dev,SSD1327ZB_GRAYSCALE_15,SSD1327ZB_GRAYSCALE_0);
+
+    // Contrast and gray scale table have the reset values, no fade running
+    dev->contrast = SSD1327ZB_CONTRAST_RESET;
+    dev->contrastStep = 0;
+    dev->contrastSteps = 0;
+    SSD1327ZB_getLinearGrayTable(dev->grayTable);
+    dev->grayStep = 0;
+    dev->graySteps = 0;
+
+#if defined WARCOMEB_SSD1327ZB_STATS
+    SSD1327ZB_resetStats(dev);
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_SPRITES
+    memset(dev->sprite,0,sizeof(dev->sprite));
+    dev->background = 0;
+    dev->backgroundColor = SSD1327ZB_GRAYSCALE_0;
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_SCROLL
+    // The start line is set to 0 by the init sequence
+    dev->scrollOffset = 0;
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+    // The display memory is unknown after the reset: the first
+    // SSD1327ZB_flushDiff sends the whole frame
+    dev->isShadowValid = FALSE;
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_EXTERNAL_BUFFER
+    // The user buffer must hold at least one row
+    if ((dev->buffer == 0) || (dev->bufferSize < (dev->gdl.width/2)))
+        return GDL_ERRORS_WRONG_VALUE;
+
+    // The band is as tall as the user buffer allows
+    dev->bandRows = ((dev->bufferSize / (dev->gdl.width/2)) > dev->gdl.height) ?
+                    dev->gdl.height : (dev->bufferSize / (dev->gdl.width/2));
+    dev->bandStart = 0;
+#elif defined WARCOMEB_SSD1327ZB_BAND_ROWS
+    dev->bandRows = WARCOMEB_SSD1327ZB_BAND_ROWS;
+    dev->bandStart = 0;
+#endif
+
+//    memset(dev->buffer, 0x00, WARCOMEB_SSD1327ZB_BUFFERDIMENSION);
+
+#if defined WARCOMEB_SSD1327ZB_EMULATOR
+
+    // Nothing to configure: the bus is the emulator itself
+
+#elif defined WARCOMEB_GDL_PARALLEL
+
+    Gpio_config(dev->gdl.d0,GPIO_PINS_OUTPUT);
+    Gpio_config(dev->gdl.d1,GPIO_PINS_OUTPUT);
+    Gpio_config(dev->gdl.d2,GPIO_PINS_OUTPUT);
+    Gpio_config(dev->gdl.d3,GPIO_PINS_OUTPUT);
+    Gpio_config(dev->gdl.d4,GPIO_PINS_OUTPUT);
+    Gpio_config(dev->gdl.d5,GPIO_PINS_OUTPUT);
+    Gpio_config(dev->gdl.d6,GPIO_PINS_OUTPUT);
+    Gpio_config(dev->gdl.d7,GPIO_PINS_OUTPUT);
+
+    Gpio_config(dev->gdl.rd,GPIO_PINS_OUTPUT);
+    Gpio_config(dev->gdl.dc,GPIO_PINS_OUTPUT);
+    Gpio_config(dev->gdl.rs,GPIO_PINS_OUTPUT);
+    Gpio_config(dev->gdl.cs,GPIO_PINS_OUTPUT);
+    Gpio_config(dev->gdl.wr,GPIO_PINS_OUTPUT);
+
+    Gpio_set(dev->gdl.dc);
+    Gpio_set(dev->gdl.rd);
+    Gpio_set(dev->gdl.wr);
+    Gpio_set(dev->gdl.cs);
+    Gpio_set(dev->gdl.rs);
+
+#if defined WARCOMEB_SSD1327ZB_FAST_PORT
+    SSD1327ZB_configPort(dev);
+#endif
+
+#elif defined WARCOMEB_GDL_I2C
+
+    if (dev->address == 0)
+        dev->address = WARCOMEB_SSD1327ZB_I2C_ADDRESS;
+
+#elif defined WARCOMEB_GDL_SPI
+
+    Gpio_config(dev->csPin,GPIO_PINS_OUTPUT);
+    Gpio_config(dev->dcPin,GPIO_PINS_OUTPUT);
+
+    Gpio_set(dev->csPin);
+    Gpio_set(dev->dcPin);
+
+#endif
+
+#if !defined WARCOMEB_SSD1327ZB_EMULATOR && (defined WARCOMEB_GDL_I2C || defined WARCOMEB_GDL_SPI)
+
+    // Hardware reset of the controller
+    if (dev->rstPin != GPIO_PINS_NONE)
+    {
+        Gpio_config(dev->rstPin,GPIO_PINS_OUTPUT);
+        Gpio_clear(dev->rstPin);
+        dev->gdl.delayTime(1);
+        Gpio_set(dev->rstPin);
+        dev->gdl.delayTime(1);
+    }
+
+#endif
+
+    SSD1327ZB_sendCommand(dev,SSD1327ZB_CMD_DISPLAYON);
+    // Wait 100ms after on
+    dev->gdl.delayTime(100);
+
+    // Set display to normal
+    SSD1327ZB_sendCommand(dev,SSD1327ZB_CMD_DISPLAYNORMAL);
+
+    // Select segment re-map, COM scan direction, COM hardware configuration and
+    // de-select level
+    // They depend on producer choice
+    switch (dev->gdl.product)
+    {
+    case SSD1327ZB_PRODUCT_RAYSTAR_REX128128B:
+    {
+        const uint8_t commands[] =
+        {
+            SSD1327ZB_CMD_SEGMENTREMAP, SSD1327ZB_REMAP_ODDEVEN_COM,
+            SSD1327ZB_CMD_STARTLINE, 0,
+        };
+        SSD1327ZB_sendCommandList(dev,commands,sizeof(commands));
+    }
+        break;
+    }
+
+    return GDL_ERRORS_OK;
+}
+
+GDL_Errors SSD1327ZB_drawPixel (SSD1327ZB_Device* dev,
+                                uint8_t xPos,
+                                uint8_t yPos,
+							    SSD1327ZB_GrayScale color)
+{
+    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    SSD1327ZB_STATS_PIXEL(xPos,yPos,color);
+    if (SSD1327ZB_isRowInBuffer(dev,yPos))
+        SSD1327ZB_putPixel(dev,xPos,yPos,color);
+    SSD1327ZB_markDirty(dev,xPos,xPos,yPos,yPos);
+
+    return GDL_ERRORS_OK;
+}
+
+void SSD1327ZB_setPictureColors (SSD1327ZB_Device* dev,
+                                 SSD1327ZB_GrayScale foreground,
+                                 SSD1327ZB_GrayScale background)
+{
+    // The most significant bit of the nibble is the left pixel
+    for (uint8_t nibble = 0; nibble < 16; ++nibble)
+    {
+        uint8_t pixel[4];
+        for (uint8_t i = 0; i < 4; ++i)
+        {
+            pixel[i] = (nibble & (0x08 >> i)) ? (foreground & 0x0F) : (background & 0x0F);
+        }
+        dev->pictureLut[nibble][0] = pixel[0] | (pixel[1] << 4);
+        dev->pictureLut[nibble][1] = pixel[2] | (pixel[3] << 4);
+    }
+}
+
+void SSD1327ZB_setContrast (SSD1327ZB_Device* dev, uint8_t value)
+{
+    uint8_t commands[] = {SSD1327ZB_CMD_SETCONTRAST, value};
+    SSD1327ZB_sendCommandList(dev,commands,sizeof(commands));
+
+    dev->contrast = value;
+    // A new value stops the fade
+    dev->contrastSteps = 0;
+}
+
+void SSD1327ZB_setGrayTable (SSD1327ZB_Device* dev, const uint8_t* table)
+{
+    uint8_t commands[1 + SSD1327ZB_GRAYTABLE_SIZE] = {SSD1327ZB_CMD_GRAYTABLE};
+    memcpy(&commands[1],table,SSD1327ZB_GRAYTABLE_SIZE);
+    SSD1327ZB_sendCommandList(dev,commands,sizeof(commands));
+
+    memmove(dev->grayTable,table,SSD1327ZB_GRAYTABLE_SIZE);
+    // A new table stops the fade
+    dev->graySteps = 0;
+}
+
+void SSD1327ZB_setLinearGrayTable (SSD1327ZB_Device* dev)
+{
+    SSD1327ZB_sendCommand(dev,SSD1327ZB_CMD_LINEARGRAYTABLE);
+
+    SSD1327ZB_getLinearGrayTable(dev->grayTable);
+    dev->graySteps = 0;
+}
+
+void SSD1327ZB_fadeContrast (SSD1327ZB_Device* dev,
+                             uint8_t value,
+                             uint16_t steps)
+{
+    if (steps == 0)
+    {
+        SSD1327ZB_setContrast(dev,value);
+        return;
+    }
+
+    dev->contrastFrom = dev->contrast;
+    dev->contrastTo = value;
+    dev->contrastStep = 0;
+    dev->contrastSteps = steps;
+}
+
+void SSD1327ZB_fadeGrayTable (SSD1327ZB_Device* dev,
+                              const uint8_t* table,
+                              uint16_t steps)
+{
+    if (steps == 0)
+    {
+        SSD1327ZB_setGrayTable(dev,table);
+        return;
+    }
+
+    memcpy(dev->grayFrom,dev->grayTable,SSD1327ZB_GRAYTABLE_SIZE);
+    memcpy(dev->grayTo,table,SSD1327ZB_GRAYTABLE_SIZE);
+    dev->grayStep = 0;
+    dev->graySteps = steps;
+}
+
+/**
+ * The function return the value reached by a fade after some steps.
+ */
+static uint8_t SSD1327ZB_fadeValue (uint8_t from,
+                                    uint8_t to,
+                                    uint16_t step,
+                                    uint16_t steps)
+{
+    // Floor rounding keeps strictly increasing tables strictly increasing
+    int32_t delta = ((int32_t)to - from) * step;
+    return from + ((delta >= 0) ? (delta / steps) : -((-delta + steps - 1) / steps));
+}
+
+bool SSD1327ZB_fadeTick (SSD1327ZB_Device* dev)
+{
+    if (dev->contrastSteps != 0)
+    {
+        dev->contrastStep++;
+        uint16_t steps = dev->contrastSteps;
+        uint8_t value = SSD1327ZB_fadeValue(dev->contrastFrom,
+                                            dev->contrastTo,
+                                            dev->contrastStep,
+                                            steps);
+        // Slow fades do not resend the same value
+        if (value != dev->contrast)
+            SSD1327ZB_setContrast(dev,value);
+
+        dev->contrastSteps = (dev->contrastStep < steps) ? steps : 0;
+    }
+
+    if (dev->graySteps != 0)
+    {
+        dev->grayStep++;
+        uint16_t steps = dev->graySteps;
+        uint8_t table[SSD1327ZB_GRAYTABLE_SIZE];
+        for (uint8_t i = 0; i < SSD1327ZB_GRAYTABLE_SIZE; ++i)
+        {
+            table[i] = SSD1327ZB_fadeValue(dev->grayFrom[i],dev->grayTo[i],dev->grayStep,steps);
+        }
+        if (memcmp(table,dev->grayTable,SSD1327ZB_GRAYTABLE_SIZE) != 0)
+            SSD1327ZB_setGrayTable(dev,table);
+
+        dev->graySteps = (dev->grayStep < steps) ? steps : 0;
+    }
+
+    return (dev->contrastSteps != 0) || (dev->graySteps != 0);
+}
+
+/**
+ * The function send a window of the buffer. The rows are the physical rows
+ * of the buffer, equal to the rows of the display memory.
+ * The window is always sent row by row. The vertical address increment of
+ * the remap command would send the same bytes, plus a remap command every
+ * time the shape of the windows changes, so it is not used.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The x start position
+ * @param[in] xStop The x stop position
+ * @param[in] yStart The first row into the buffer
+ * @param[in] yStop The last row into the buffer
+ */
+static void SSD1327ZB_sendWindow (SSD1327ZB_Device* dev,
+                                  uint8_t xStart,
+                                  uint8_t xStop,
+                                  uint8_t yStart,
+                                  uint8_t yStop)
+{
+    // Commands and pixels into a single transaction, unless the caller
+    // already holds the display
+    const bool isHeld = dev->isSelected;
+    SSD1327ZB_selectDevice(dev);
+
+    // Set the part of the display where change the pixels
+    GDL_Errors error = SSD1327ZB_setBufferPosition(dev,xStart,xStop,yStart,yStop);
+    if (error != GDL_ERRORS_OK)
+    {
+        if (!isHeld) SSD1327ZB_releaseDevice(dev);
+        return;
+    }
+
+    uint8_t xStartHalf = xStart/2;
+    uint8_t xStopHalf = xStop/2;
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+    uint8_t widthHalf = dev->gdl.width/2;
+#endif
+
+    SSD1327ZB_STATS_ADD(dataBytes,(uint16_t)(yStop - yStart + 1) * (xStopHalf - xStartHalf + 1));
+
+    // All the rows are sent into a single transfer
+    SSD1327ZB_beginTransfer(dev,TRUE);
+    for (uint8_t i = yStart; i <= yStop; i++)
+    {
+        const uint8_t* row = SSD1327ZB_getBufferRow(dev,i);
+        for (uint8_t j = xStartHalf; j <= xStopHalf; j++)
+        {
+            SSD1327ZB_transferByte(dev,row[j]);
+        }
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+        memcpy(&dev->shadow[(i * widthHalf) + xStartHalf],&row[xStartHalf],xStopHalf - xStartHalf + 1);
+#endif
+    }
+    SSD1327ZB_endTransfer(dev);
+    if (!isHeld) SSD1327ZB_releaseDevice(dev);
+}
+
+void SSD1327ZB_flush (SSD1327ZB_Device* dev)
+{
+    SSD1327ZB_STATS_BEGIN();
+
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    // Only the current band is into the buffer
+    SSD1327ZB_sendWindow(dev,0,dev->gdl.width-1,dev->bandStart,SSD1327ZB_getBandStop(dev));
+#else
     // Set the cursor to the starting point of the display
-    // Print all the buffer
+    // Print all the buffer, commands and pixels into a single transaction
+    SSD1327ZB_selectDevice(dev);
     SSD1327ZB_setBufferPosition(dev,0,dev->gdl.width-1,0,dev->gdl.height-1);
 
-    for (uint16_t i = 0; i < WARCOMEB_SSD1327ZB_BUFFERDIMENSION; i++)
+    SSD1327ZB_sendDataBlock(dev,dev->buffer,SSD1327ZB_getFrameSize(dev));
+    SSD1327ZB_releaseDevice(dev);
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+    memcpy(dev->shadow,dev->buffer,SSD1327ZB_getFrameSize(dev));
+    dev->isShadowValid = TRUE;
+#endif
+
+    // The whole display is now updated
+    dev->dirtyCount = 0;
+
+    SSD1327ZB_STATS_END(flushes);
+}
+
+/**
+ * The function convert an area of the display into the rows of the buffer.
+ * When the scroll is enabled the area can wrap around the end of the
+ * buffer and it is split in two parts.
+ *
+ * @return The number of parts, 0 if the area is wrong.
+ */
+static uint8_t SSD1327ZB_toBufferRows (SSD1327ZB_Device* dev,
+                                       const SSD1327ZB_Area* area,
+                                       SSD1327ZB_Area* parts)
+{
+    if ((area->yStart > area->yStop) || (area->yStop >= dev->gdl.height))
+        return 0;
+
+    parts[0] = *area;
+
+    // Only the rows held by the buffer can be sent
+    if (!SSD1327ZB_clipRows(dev,&parts[0].yStart,&parts[0].yStop))
+        return 0;
+
+#if defined WARCOMEB_SSD1327ZB_SCROLL
+    uint16_t start = area->yStart + dev->scrollOffset;
+    uint16_t stop = area->yStop + dev->scrollOffset;
+    if (start >= dev->gdl.height)
+    {
+        start -= dev->gdl.height;
+        stop -= dev->gdl.height;
+    }
+
+    parts[0].yStart = start;
+    if (stop >= dev->gdl.height)
+    {
+        parts[0].yStop = dev->gdl.height - 1;
+        parts[1] = *area;
+        parts[1].yStart = 0;
+        parts[1].yStop = stop - dev->gdl.height;
+        return 2;
+    }
+    parts[0].yStop = stop;
+#endif
+
+    return 1;
+}
+
+void SSD1327ZB_flushPart (SSD1327ZB_Device* dev,
+                          uint8_t xStart,
+                          uint8_t xStop,
+                          uint8_t yStart,
+                          uint8_t yStop)
+{
+    SSD1327ZB_STATS_BEGIN();
+
+    SSD1327ZB_Area area = {xStart, xStop, yStart, yStop};
+    SSD1327ZB_Area parts[2];
+
+    uint8_t count = SSD1327ZB_toBufferRows(dev,&area,parts);
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        SSD1327ZB_sendWindow(dev,parts[i].xStart,parts[i].xStop,parts[i].yStart,parts[i].yStop);
+    }
+
+    SSD1327ZB_STATS_END(flushParts);
+}
+
+void SSD1327ZB_flushGroup (SSD1327ZB_Device** group, uint8_t count)
+{
+    for (uint8_t k = 0; k < count; ++k)
+    {
+        SSD1327ZB_Device* dev = group[k];
+        if (dev->dirtyCount == 0) continue;
+
+        SSD1327ZB_STATS_BEGIN();
+
+        // All the windows of the display are sent with a single selection
+        SSD1327ZB_selectDevice(dev);
+        for (uint8_t i = 0; i < dev->dirtyCount; ++i)
+        {
+            SSD1327ZB_Area parts[2];
+            uint8_t partCount = SSD1327ZB_toBufferRows(dev,&dev->dirty[i],parts);
+            for (uint8_t j = 0; j < partCount; ++j)
+            {
+                SSD1327ZB_sendWindow(dev,parts[j].xStart,parts[j].xStop,parts[j].yStart,parts[j].yStop);
+            }
+        }
+        SSD1327ZB_releaseDevice(dev);
+        dev->dirtyCount = 0;
+
+        SSD1327ZB_STATS_END(flushGroups);
+    }
+}
+
+void SSD1327ZB_flushBegin (SSD1327ZB_Device* dev)
+{
+    if (SSD1327ZB_flushBusy(dev)) return;
+
+    // The dirty list is moved into the queue: new changes are marked
+    // again and sent by the next flush
+    dev->flushQueueCount = 0;
+    for (uint8_t i = 0; i < dev->dirtyCount; ++i)
+    {
+        dev->flushQueueCount += SSD1327ZB_toBufferRows(dev,
+                                                       &dev->dirty[i],
+                                                       &dev->flushQueue[dev->flushQueueCount]);
+    }
+    dev->dirtyCount = 0;
+
+    dev->flushArea = 0;
+    dev->flushRow = dev->flushQueue[0].yStart;
+    dev->isFlushWindowOpen = FALSE;
+}
+
+uint16_t SSD1327ZB_flushStep (SSD1327ZB_Device* dev, uint16_t budget)
+{
+    SSD1327ZB_STATS_BEGIN();
+
+    uint16_t sent = 0;
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+    const uint8_t widthHalf = dev->gdl.width/2;
+#endif
+
+    while (SSD1327ZB_flushBusy(dev))
+    {
+        const SSD1327ZB_Area* area = &dev->flushQueue[dev->flushArea];
+        const uint8_t xStartHalf = area->xStart/2;
+        const uint8_t rowLength = (area->xStop/2) - xStartHalf + 1;
+
+        uint16_t cost = rowLength + ((dev->isFlushWindowOpen) ? 0 : SSD1327ZB_WINDOW_COST);
+        // At least one row for every call
+        if ((sent > 0) && ((sent + cost) > budget)) break;
+
+        if (!dev->isFlushWindowOpen)
+        {
+            // The window start from the next row to be sent
+            SSD1327ZB_setBufferPosition(dev,area->xStart,area->xStop,dev->flushRow,area->yStop);
+            dev->isFlushWindowOpen = TRUE;
+            sent += SSD1327ZB_WINDOW_COST;
+        }
+
+        // Send as many whole rows as the budget allows
+        SSD1327ZB_beginTransfer(dev,TRUE);
+        do
+        {
+            const uint8_t* row = SSD1327ZB_getBufferRow(dev,dev->flushRow) + xStartHalf;
+            for (uint8_t j = 0; j < rowLength; j++)
+            {
+                SSD1327ZB_transferByte(dev,row[j]);
+            }
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+            memcpy(&dev->shadow[(dev->flushRow * widthHalf) + xStartHalf],row,rowLength);
+#endif
+            SSD1327ZB_STATS_ADD(dataBytes,rowLength);
+            sent += rowLength;
+            dev->flushRow++;
+        }
+        while ((dev->flushRow <= area->yStop) && ((sent + rowLength) <= budget));
+        SSD1327ZB_endTransfer(dev);
+
+        if (dev->flushRow > area->yStop)
+        {
+            // Next area
+            dev->flushArea++;
+            if (dev->flushArea < dev->flushQueueCount)
+                dev->flushRow = dev->flushQueue[dev->flushArea].yStart;
+            dev->isFlushWindowOpen = FALSE;
+        }
+    }
+
+    SSD1327ZB_STATS_END(flushSteps);
+    return sent;
+}
+
+bool SSD1327ZB_flushBusy (SSD1327ZB_Device* dev)
+{
+    return (dev->flushArea < dev->flushQueueCount) ? TRUE : FALSE;
+}
+
+void SSD1327ZB_setFrameRate (SSD1327ZB_Device* dev,
+                             uint8_t fps,
+                             uint16_t budget)
+{
+    dev->frameInterval = (fps == 0) ? 0 : (1000 / fps);
+    dev->frameBudget = budget;
+}
+
+bool SSD1327ZB_frameTick (SSD1327ZB_Device* dev, uint32_t now)
+{
+    // The unsigned difference is right also when the clock wraps around
+    if ((now - dev->frameStart) < dev->frameInterval)
+        return FALSE;
+
+    if (!SSD1327ZB_flushBusy(dev))
+    {
+        if (dev->dirtyCount == 0) return FALSE;
+
+        SSD1327ZB_flushBegin(dev);
+
+        // Cheapest areas first, so most of the changes are shown by the
+        // first frame and only the big areas are carried over
+        for (uint8_t i = 1; i < dev->flushQueueCount; ++i)
+        {
+            SSD1327ZB_Area area = dev->flushQueue[i];
+            uint16_t cost = SSD1327ZB_areaCost(&area);
+            uint8_t j = i;
+            for (; (j > 0) && (SSD1327ZB_areaCost(&dev->flushQueue[j-1]) > cost); --j)
+            {
+                dev->flushQueue[j] = dev->flushQueue[j-1];
+            }
+            dev->flushQueue[j] = area;
+        }
+        dev->flushRow = dev->flushQueue[0].yStart;
+    }
+
+    dev->frameStart = now;
+    SSD1327ZB_flushStep(dev,(dev->frameBudget == 0) ? 0xFFFF : dev->frameBudget);
+    return TRUE;
+}
+
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+
+/**
+ * The function return the index of the first different byte of two rows,
+ * starting from the selected position and comparing a word at a time.
+ *
+ * @return The index of the byte, or length if the rows are equal.
+ */
+static uint8_t SSD1327ZB_findChanged (const uint8_t* a,
+                                      const uint8_t* b,
+                                      uint8_t start,
+                                      uint8_t length)
+{
+    uint8_t i = start;
+
+    for (; (i + sizeof(uint32_t)) <= length; i += sizeof(uint32_t))
+    {
+        uint32_t wordA, wordB;
+        memcpy(&wordA,&a[i],sizeof(uint32_t));
+        memcpy(&wordB,&b[i],sizeof(uint32_t));
+        if (wordA != wordB) break;
+    }
+    for (; i < length; ++i)
+    {
+        if (a[i] != b[i]) return i;
+    }
+    return length;
+}
+
+/**
+ * The function send a window of whole column pairs and copy it into the
+ * shadow memory.
+ */
+static void SSD1327ZB_sendDiffWindow (SSD1327ZB_Device* dev, const SSD1327ZB_Area* area)
+{
+    SSD1327ZB_sendWindow(dev,area->xStart*2,area->xStop*2,area->yStart,area->yStop);
+}
+
+void SSD1327ZB_flushDiff (SSD1327ZB_Device* dev)
+{
+    if (!dev->isShadowValid)
+    {
+        // The content of the display is unknown
+        SSD1327ZB_flush(dev);
+        return;
+    }
+
+    SSD1327ZB_STATS_BEGIN();
+
+    const uint8_t widthHalf = dev->gdl.width/2;
+    SSD1327ZB_Area pending = {0};
+    bool isPending = FALSE;
+
+    for (uint8_t y = 0; y < dev->gdl.height; ++y)
+    {
+        const uint8_t* row = &dev->buffer[y * widthHalf];
+        const uint8_t* shadow = &dev->shadow[y * widthHalf];
+
+        // Fast skip of unchanged rows
+        uint8_t first = SSD1327ZB_findChanged(row,shadow,0,widthHalf);
+        if (first == widthHalf) continue;
+
+        // Collect the runs of changed bytes, joining the runs that are
+        // closer than the cost of a new window
+        uint8_t runStart = first;
+        uint8_t runStop = first;
+        uint8_t i = first + 1;
+        SSD1327ZB_Area runs [WARCOMEB_SSD1327ZB_WIDTH/2];
+        uint8_t runsCount = 0;
+
+        while (i < widthHalf)
+        {
+            uint8_t next = SSD1327ZB_findChanged(row,shadow,i,widthHalf);
+            if (next == widthHalf) break;
+
+            // Extend the run through the changed bytes
+            uint8_t stop = next;
+            while (((stop + 1) < widthHalf) && (row[stop + 1] != shadow[stop + 1]))
+                stop++;
+
+            if ((next - runStop - 1) > SSD1327ZB_WINDOW_COST)
+            {
+                runs[runsCount].xStart = runStart;
+                runs[runsCount].xStop = runStop;
+                runsCount++;
+                runStart = next;
+            }
+            runStop = stop;
+            i = stop + 1;
+        }
+        runs[runsCount].xStart = runStart;
+        runs[runsCount].xStop = runStop;
+        runsCount++;
+
+        for (uint8_t r = 0; r < runsCount; ++r)
+        {
+            runs[r].yStart = y;
+            runs[r].yStop = y;
+
+            // A single span equal to the previous row extend its window
+            if ((runsCount == 1) && isPending &&
+                (pending.yStop == (y - 1)) &&
+                (pending.xStart == runs[r].xStart) &&
+                (pending.xStop == runs[r].xStop))
+            {
+                pending.yStop = y;
+                continue;
+            }
+
+            if (isPending)
+                SSD1327ZB_sendDiffWindow(dev,&pending);
+
+            pending = runs[r];
+            isPending = TRUE;
+        }
+    }
+
+    if (isPending)
+        SSD1327ZB_sendDiffWindow(dev,&pending);
+
+    dev->dirtyCount = 0;
+
+    SSD1327ZB_STATS_END(flushDiffs);
+}
+
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_SCROLL
+
+void SSD1327ZB_scroll (SSD1327ZB_Device* dev,
+                       int16_t lines,
+                       SSD1327ZB_GrayScale background)
+{
+    const int16_t height = dev->gdl.height;
+
+    if (lines == 0) return;
+
+    if ((lines >= height) || (lines <= -height))
+    {
+        // Nothing of the old content remain visible
+        SSD1327ZB_fillArea(dev,0,dev->gdl.width-1,0,height-1,background);
+        SSD1327ZB_markDirty(dev,0,dev->gdl.width-1,0,height-1);
+        return;
+    }
+
+    // Move the ring of rows and the start line of the display
+    int16_t offset = dev->scrollOffset + lines;
+    if (offset >= height) offset -= height;
+    if (offset < 0) offset += height;
+    dev->scrollOffset = offset;
+
+    uint8_t commands[] = {SSD1327ZB_CMD_STARTLINE, dev->scrollOffset};
+    SSD1327ZB_sendCommandList(dev,commands,sizeof(commands));
+
+    // The pending areas move with the content
+    uint8_t i = 0;
+    while (i < dev->dirtyCount)
+    {
+        int16_t start = dev->dirty[i].yStart - lines;
+        int16_t stop = dev->dirty[i].yStop - lines;
+        if (start < 0) start = 0;
+        if (stop >= height) stop = height - 1;
+
+        if (start > stop)
+        {
+            dev->dirty[i] = dev->dirty[--dev->dirtyCount];
+            continue;
+        }
+        dev->dirty[i].yStart = start;
+        dev->dirty[i].yStop = stop;
+        i++;
+    }
+
+    // The exposed rows still show the old content
+    uint8_t yStart = (lines > 0) ? (height - lines) : 0;
+    uint8_t yStop = (lines > 0) ? (height - 1) : (-lines - 1);
+    SSD1327ZB_fillArea(dev,0,dev->gdl.width-1,yStart,yStop,background);
+    SSD1327ZB_markDirty(dev,0,dev->gdl.width-1,yStart,yStop);
+}
+
+#endif
+
+void SSD1327ZB_startHorizontalScroll (SSD1327ZB_Device* dev,
+                                      SSD1327ZB_ScrollDirection direction,
+                                      uint8_t xStart,
+                                      uint8_t xStop,
+                                      uint8_t yStart,
+                                      uint8_t yStop,
+                                      uint8_t interval)
+{
+    const uint8_t commands[] =
+    {
+        SSD1327ZB_CMD_SCROLLSTOP,
+        direction,
+        0x00,            // Dummy byte
+        (yStart + dev->yOffset) & 0x7F,
+        interval & 0x07,
+        (yStop + dev->yOffset) & 0x7F,
+        ((xStart + dev->xOffset)/2) & 0x3F,
+        ((xStop + dev->xOffset)/2) & 0x3F,
+        SSD1327ZB_CMD_SCROLLSTART,
+    };
+    SSD1327ZB_sendCommandList(dev,commands,sizeof(commands));
+
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+    // The controller moves the display memory
+    dev->isShadowValid = FALSE;
+#endif
+}
+
+void SSD1327ZB_stopHorizontalScroll (SSD1327ZB_Device* dev)
+{
+    SSD1327ZB_sendCommand(dev,SSD1327ZB_CMD_SCROLLSTOP);
+
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+    // The scroll has moved the display memory
+    dev->isShadowValid = FALSE;
+#endif
+}
+
+void SSD1327ZB_clear (SSD1327ZB_Device* dev)
+{
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    // The same empty band is sent in every position
+    memset(dev->buffer, 0x00, (uint16_t) dev->bandRows * (dev->gdl.width/2));
+    for (uint16_t start = 0; start < dev->gdl.height; start += dev->bandRows)
+    {
+        SSD1327ZB_setBand(dev,start);
+        SSD1327ZB_sendWindow(dev,0,dev->gdl.width-1,start,SSD1327ZB_getBandStop(dev));
+    }
+    // The empty buffer is right for every band
+    SSD1327ZB_setBand(dev,0);
+    dev->dirtyCount = 0;
+#else
+    // Reset memory buffer
+    memset(dev->buffer, 0x00, SSD1327ZB_getFrameSize(dev));
+    // Flush the new buffer
+    SSD1327ZB_flush(dev);
+#endif
+}
+
+void SSD1327ZB_render (SSD1327ZB_Device* dev,
+                       SSD1327ZB_RenderCallback callback,
+                       void* context)
+{
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    const uint16_t bandSize = (uint16_t) dev->bandRows * (dev->gdl.width/2);
+
+    for (uint16_t start = 0; start < dev->gdl.height; start += dev->bandRows)
+    {
+        // Draw the band and send it before the next one
+        SSD1327ZB_setBand(dev,start);
+        memset(dev->buffer,0x00,bandSize);
+        callback(dev,context);
+        SSD1327ZB_sendWindow(dev,0,dev->gdl.width-1,start,SSD1327ZB_getBandStop(dev));
+    }
+    // The last band stays selected: it is the content of the buffer
+#else
+    memset(dev->buffer,0x00,SSD1327ZB_getFrameSize(dev));
+    callback(dev,context);
+    SSD1327ZB_flush(dev);
+#endif
+
+    // The whole display is now updated
+    dev->dirtyCount = 0;
+}
+
+#define SSD1327ZB_LINE_STEP_X                    0x01
+#define SSD1327ZB_LINE_STEP_Y                    0x02
+
+/**
+ * The function move a line to its next pixel with the Bresenham algorithm.
+ *
+ * @return The axes moved, SSD1327ZB_LINE_STEP_X and SSD1327ZB_LINE_STEP_Y.
+ */
+static inline uint8_t SSD1327ZB_stepLine (int16_t* x,
+                                          int16_t* y,
+                                          int16_t* error,
+                                          int16_t dx,
+                                          int16_t dy,
+                                          int8_t xStep,
+                                          int8_t yStep)
+{
+    uint8_t moved = 0;
+    int16_t error2 = 2 * *error;
+
+    if (error2 >= dy)
+    {
+        *error += dy;
+        *x += xStep;
+        moved |= SSD1327ZB_LINE_STEP_X;
+    }
+    if (error2 <= dx)
+    {
+        *error += dx;
+        *y += yStep;
+        moved |= SSD1327ZB_LINE_STEP_Y;
+    }
+    return moved;
+}
+
+void SSD1327ZB_drawLine (SSD1327ZB_Device* dev,
+                         uint8_t xStart,
+                         uint8_t yStart,
+                         uint8_t xStop,
+                         uint8_t yStop,
+                         SSD1327ZB_GrayScale color)
+{
+    const int16_t width = dev->gdl.width;
+    const int16_t height = dev->gdl.height;
+
+    // Both ends on the same outer side: nothing to draw
+    if (((xStart >= width) && (xStop >= width)) ||
+        ((yStart >= height) && (yStop >= height)))
+        return;
+
+    if (xStart == xStop)
+    {
+        if (yStart < yStop)
+            SSD1327ZB_drawVLine(dev,xStart,yStart,yStop-yStart,color);
+        else
+            SSD1327ZB_drawVLine(dev,xStart,yStop,yStart-yStop,color);
+        return;
+    }
+
+    int16_t dx = (xStop > xStart) ? (xStop - xStart) : (xStart - xStop);
+    int16_t dy = (yStop > yStart) ? (yStart - yStop) : (yStop - yStart);
+    int8_t xStep = (xStart < xStop) ? 1 : -1;
+    int8_t yStep = (yStart < yStop) ? 1 : -1;
+    int16_t error = dx + dy;
+    int16_t x = xStart, y = yStart;
+
+    // Walk from the real start up to the first visible pixel without
+    // writing, so the visible part keeps the raster of the whole line
+    while ((x >= width) || (y >= height))
+    {
+        if ((x == xStop) && (y == yStop)) return;
+        SSD1327ZB_stepLine(&x,&y,&error,dx,dy,xStep,yStep);
+    }
+
+    const int16_t xFirst = x, yFirst = y;
+
+#if !defined WARCOMEB_SSD1327ZB_BANDED
+    // Move a pointer and a nibble selector into the buffer
+    const int16_t stride = (yStep > 0) ? (dev->gdl.width/2) : -(dev->gdl.width/2);
+    const uint8_t low = color & 0x0F;
+    const uint8_t high = low << 4;
+
+    uint8_t* pixel = SSD1327ZB_getRow(dev,y) + (x/2);
+    bool isOdd = x%2;
+#endif
+
+    for (;;)
+    {
+#if defined WARCOMEB_SSD1327ZB_BANDED
+        if (SSD1327ZB_isRowInBuffer(dev,y))
+            SSD1327ZB_putPixel(dev,x,y,color);
+#else
+        if (isOdd)
+            *pixel = high | (*pixel & 0x0F);
+        else
+            *pixel = low | (*pixel & 0xF0);
+#endif
+
+        if ((x == xStop) && (y == yStop)) break;
+
+        int16_t xNext = x, yNext = y;
+        uint8_t moved = SSD1327ZB_stepLine(&xNext,&yNext,&error,dx,dy,xStep,yStep);
+
+        // The visible pixels are a single piece of the line
+        if ((xNext >= width) || (yNext >= height)) break;
+
+#if !defined WARCOMEB_SSD1327ZB_BANDED
+        if (moved & SSD1327ZB_LINE_STEP_X)
+        {
+            // Move to the next nibble
+            if (xStep > 0)
+                pixel += isOdd;
+            else
+                pixel -= !isOdd;
+            isOdd = !isOdd;
+        }
+        if (moved & SSD1327ZB_LINE_STEP_Y)
+            pixel = SSD1327ZB_moveRows(dev,pixel,stride);
+#else
+        (void) moved;
+#endif
+        x = xNext;
+        y = yNext;
+    }
+
+    SSD1327ZB_markDirty(dev,
+                        (xFirst < x) ? xFirst : x,
+                        (xFirst < x) ? x : xFirst,
+                        (yFirst < y) ? yFirst : y,
+                        (yFirst < y) ? y : yFirst);
+}
+
+void SSD1327ZB_drawHLine (SSD1327ZB_Device* dev,
+                          uint8_t xStart,
+                          uint8_t yStart,
+                          uint8_t width,
+                          SSD1327ZB_GrayScale color)
+{
+    if ((xStart >= dev->gdl.width) || (yStart >= dev->gdl.height))
+        return;
+
+    // The line include both the start and the end pixel
+    uint16_t xStop = (uint16_t) xStart + width;
+    if (xStop >= dev->gdl.width) xStop = dev->gdl.width - 1;
+
+    if (SSD1327ZB_isRowInBuffer(dev,yStart))
+        SSD1327ZB_fillSpan(SSD1327ZB_getRow(dev,yStart),xStart,xStop,color);
+    SSD1327ZB_markDirty(dev,xStart,xStop,yStart,yStart);
+}
+
+void SSD1327ZB_drawVLine (SSD1327ZB_Device* dev,
+                          uint8_t xStart,
+                          uint8_t yStart,
+                          uint8_t height,
+                          SSD1327ZB_GrayScale color)
+{
+    if ((xStart >= dev->gdl.width) || (yStart >= dev->gdl.height))
+        return;
+
+    // The line include both the start and the end pixel
+    uint16_t yStop = (uint16_t) yStart + height;
+    if (yStop >= dev->gdl.height) yStop = dev->gdl.height - 1;
+
+    SSD1327ZB_markDirty(dev,xStart,xStart,yStart,yStop);
+
+    uint8_t yFirst = yStart, yLast = yStop;
+    if (!SSD1327ZB_clipRows(dev,&yFirst,&yLast)) return;
+
+    // Fixed stride walk with a fixed nibble
+    const uint8_t stride = dev->gdl.width/2;
+    const uint8_t keep = (xStart%2) ? 0x0F : 0xF0;
+    const uint8_t value = (xStart%2) ? ((color << 4) & 0xF0) : (color & 0x0F);
+    uint8_t* pixel = SSD1327ZB_getRow(dev,yFirst) + (xStart/2);
+
+    for (uint8_t y = yFirst; ; ++y)
+    {
+        *pixel = value | (*pixel & keep);
+
+        // Stop before the pointer leave the buffer
+        if (y == yLast) break;
+        pixel = SSD1327ZB_moveRows(dev,pixel,stride);
+    }
+}
+
+void SSD1327ZB_drawRectangle (SSD1327ZB_Device* dev,
+                              uint16_t xStart,
+                              uint16_t yStart,
+                              uint16_t width,
+                              uint16_t height,
+                              SSD1327ZB_GrayScale color,
+                              bool isFill)
+{
+    if (isFill)
+    {
+        // Clip once, then fill whole bytes
+        if ((width == 0) || (height == 0)) return;
+        if ((xStart >= dev->gdl.width) || (yStart >= dev->gdl.height)) return;
+
+        uint16_t xStop = xStart + width - 1;
+        uint16_t yStop = yStart + height - 1;
+        if (xStop >= dev->gdl.width)  xStop = dev->gdl.width - 1;
+        if (yStop >= dev->gdl.height) yStop = dev->gdl.height - 1;
+
+        SSD1327ZB_fillArea(dev,xStart,xStop,yStart,yStop,color);
+        SSD1327ZB_markDirty(dev,xStart,xStop,yStart,yStop);
+        return;
+    }
+
+    SSD1327ZB_beginDraw(dev);
+    GDL_drawRectangle(&(dev->gdl),xStart,yStart,width,height,(uint8_t)color,isFill);
+    SSD1327ZB_endDraw(dev);
+}
+
+#if defined WARCOMEB_SSD1327ZB_GLYPH_CACHE_SIZE
+
+/**
+ * Callback used to render a glyph into its cache slot.
+ */
+static GDL_Errors SSD1327ZB_glyphCaptureCallback (SSD1327ZB_Device* dev,
+                                                  uint8_t xPos,
+                                                  uint8_t yPos,
+                                                  SSD1327ZB_GrayScale color)
+{
+    if (xPos < dev->drawBox.xStart) dev->drawBox.xStart = xPos;
+    if (xPos > dev->drawBox.xStop)  dev->drawBox.xStop  = xPos;
+    if (yPos < dev->drawBox.yStart) dev->drawBox.yStart = yPos;
+    if (yPos > dev->drawBox.yStop)  dev->drawBox.yStop  = yPos;
+
+    // Too big glyphs are discarded at the end of the rendering
+    if ((xPos >= WARCOMEB_SSD1327ZB_GLYPH_MAX_WIDTH) ||
+        (yPos >= WARCOMEB_SSD1327ZB_GLYPH_MAX_HEIGHT))
+        return GDL_ERRORS_OK;
+
+    uint8_t* pixel = &dev->glyphData[dev->glyphCapture][(yPos * WARCOMEB_SSD1327ZB_GLYPH_STRIDE) + (xPos/2)];
+    if (xPos%2)
+        *pixel = (((color << 4) & 0xF0) | (*pixel & 0x0F));
+    else
+        *pixel = ((color & 0x0F) | (*pixel & 0xF0));
+
+    return GDL_ERRORS_OK;
+}
+
+void SSD1327ZB_clearGlyphCache (SSD1327ZB_Device* dev)
+{
+    for (uint8_t i = 0; i < WARCOMEB_SSD1327ZB_GLYPH_SLOTS; ++i)
+    {
+        dev->glyph[i].width = 0;
+    }
+    dev->glyphClock = 0;
+    dev->glyphCapture = -1;
+}
+
+/**
+ * The function search a glyph into the cache. When it is missing, the glyph
+ * is rendered through GDL into the least recently used slot.
+ *
+ * @return The index of the slot, -1 if the glyph can not be cached.
+ */
+static int16_t SSD1327ZB_getGlyph (SSD1327ZB_Device* dev,
+                                   uint8_t c,
+                                   SSD1327ZB_GrayScale color,
+                                   SSD1327ZB_GrayScale background,
+                                   uint8_t size)
+{
+    const uint8_t colors = ((color << 4) & 0xF0) | (background & 0x0F);
+    const void* font = (dev->gdl.useCustomFont) ? dev->gdl.customFont : 0;
+    uint8_t victim = 0;
+    uint16_t victimAge = 0;
+
+    dev->glyphClock++;
+
+    for (uint8_t i = 0; i < WARCOMEB_SSD1327ZB_GLYPH_SLOTS; ++i)
+    {
+        SSD1327ZB_Glyph* glyph = &dev->glyph[i];
+        if (glyph->width == 0)
+        {
+            // Empty slots are used first
+            victim = i;
+            victimAge = 0xFFFF;
+            continue;
+        }
+
+        if ((glyph->c == c) &&
+            (glyph->size == size) &&
+            (glyph->colors == colors) &&
+            (glyph->font == font))
+        {
+            glyph->lastUse = dev->glyphClock;
+            return i;
+        }
+
+        uint16_t age = dev->glyphClock - glyph->lastUse;
+        if (age > victimAge)
+        {
+            victim = i;
+            victimAge = age;
+        }
+    }
+
+    // Render the glyph at the origin of an empty slot
+    SSD1327ZB_Glyph* glyph = &dev->glyph[victim];
+    // Pixels not written by the font keep the background color
+    memset(dev->glyphData[victim],(background & 0x0F) * 0x11,WARCOMEB_SSD1327ZB_GLYPH_SLOT_SIZE);
+
+    dev->glyphCapture = victim;
+    dev->gdl.drawPixel = SSD1327ZB_glyphCaptureCallback;
+    SSD1327ZB_beginDraw(dev);
+    GDL_Errors error = GDL_drawChar(&(dev->gdl),0,0,c,(uint8_t)color,(uint8_t)background,size);
+    dev->gdl.drawPixel = SSD1327ZB_drawPixelCallback;
+    dev->glyphCapture = -1;
+
+    if ((error != GDL_ERRORS_OK) ||
+        (dev->drawBox.xStart > dev->drawBox.xStop) ||
+        (dev->drawBox.xStop >= WARCOMEB_SSD1327ZB_GLYPH_MAX_WIDTH) ||
+        (dev->drawBox.yStop >= WARCOMEB_SSD1327ZB_GLYPH_MAX_HEIGHT))
+    {
+        glyph->width = 0;
+        return -1;
+    }
+
+    glyph->c = c;
+    glyph->size = size;
+    glyph->colors = colors;
+    glyph->font = font;
+    glyph->width = dev->drawBox.xStop + 1;
+    glyph->height = dev->drawBox.yStop + 1;
+    glyph->lastUse = dev->glyphClock;
+    return victim;
+}
+
+/**
+ * The function copy a cached glyph into the buffer, clipping it to the
+ * display.
+ */
+static void SSD1327ZB_blitGlyph (SSD1327ZB_Device* dev,
+                                 int16_t slot,
+                                 uint8_t xPos,
+                                 uint8_t yPos)
+{
+    const SSD1327ZB_Glyph* glyph = &dev->glyph[slot];
+    uint8_t width = glyph->width;
+    uint8_t height = glyph->height;
+
+    if ((xPos + width) > dev->gdl.width)   width = dev->gdl.width - xPos;
+    if ((yPos + height) > dev->gdl.height) height = dev->gdl.height - yPos;
+
+    const uint8_t* src = dev->glyphData[slot];
+    for (uint8_t row = 0; row < height; ++row, src += WARCOMEB_SSD1327ZB_GLYPH_STRIDE)
+    {
+        if (!SSD1327ZB_isRowInBuffer(dev,yPos+row)) continue;
+        SSD1327ZB_copyNibbles(SSD1327ZB_getRow(dev,yPos+row),xPos,src,0,width);
+    }
+}
+
+#endif
+
+GDL_Errors SSD1327ZB_drawChar (SSD1327ZB_Device* dev,
+                               uint16_t xPos,
+                               uint16_t yPos,
+                               uint8_t c,
+                               SSD1327ZB_GrayScale color,
+                               SSD1327ZB_GrayScale background,
+                               uint8_t size)
+{
+#if defined WARCOMEB_SSD1327ZB_GLYPH_CACHE_SIZE
+    int16_t slot = SSD1327ZB_getGlyph(dev,c,color,background,size);
+    if (slot >= 0)
+    {
+        const SSD1327ZB_Glyph* glyph = &dev->glyph[slot];
+        if (((xPos + glyph->width) > dev->gdl.width) ||
+            ((yPos + glyph->height) > dev->gdl.height))
+            return GDL_ERRORS_WRONG_POSITION;
+
+        SSD1327ZB_blitGlyph(dev,slot,xPos,yPos);
+        SSD1327ZB_markDirty(dev,xPos,xPos+glyph->width-1,yPos,yPos+glyph->height-1);
+        return GDL_ERRORS_OK;
+    }
+#endif
+
+    SSD1327ZB_beginDraw(dev);
+    GDL_Errors error = GDL_drawChar(&(dev->gdl),xPos,yPos,c,(uint8_t)color,(uint8_t)background,size);
+    SSD1327ZB_endDraw(dev);
+    return error;
+}
+
+GDL_Errors SSD1327ZB_drawString (SSD1327ZB_Device* dev,
+                                 uint16_t xPos,
+                                 uint16_t yPos,
+                                 const char* text,
+                                 SSD1327ZB_GrayScale color,
+                                 SSD1327ZB_GrayScale background,
+                                 uint8_t size)
+{
+    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    uint16_t x = xPos;
+#if defined WARCOMEB_SSD1327ZB_GLYPH_CACHE_SIZE
+    uint8_t height = 0;
+#endif
+
+    // Stop at the first char out of the display
+    for (; (*text != '\0') && (x < dev->gdl.width); ++text)
+    {
+#if defined WARCOMEB_SSD1327ZB_GLYPH_CACHE_SIZE
+        int16_t slot = SSD1327ZB_getGlyph(dev,*text,color,background,size);
+        if (slot >= 0)
+        {
+            // Only whole chars are drawn, as GDL does
+            if (((x + dev->glyph[slot].width) > dev->gdl.width) ||
+                ((yPos + dev->glyph[slot].height) > dev->gdl.height))
+                break;
+
+            SSD1327ZB_blitGlyph(dev,slot,x,yPos);
+            x += dev->glyph[slot].width;
+            if (dev->glyph[slot].height > height)
+                height = dev->glyph[slot].height;
+            continue;
+        }
+#endif
+        // The char is drawn by GDL, its width is the drawn bounding box.
+        // GDL draws only whole chars, so the string stops at the first
+        // char that does not fit.
+        SSD1327ZB_beginDraw(dev);
+        GDL_Errors error = GDL_drawChar(&(dev->gdl),x,yPos,*text,(uint8_t)color,(uint8_t)background,size);
+        SSD1327ZB_endDraw(dev);
+        if ((error != GDL_ERRORS_OK) || (dev->drawBox.xStart > dev->drawBox.xStop))
+            break;
+        x = dev->drawBox.xStop + 1;
+    }
+
+#if defined WARCOMEB_SSD1327ZB_GLYPH_CACHE_SIZE
+    // All the cached chars are marked at once
+    if (height > 0)
+        SSD1327ZB_markDirty(dev,xPos,x-1,yPos,yPos+height-1);
+#endif
+
+    return GDL_ERRORS_OK;
+}
+
+GDL_Errors SSD1327ZB_drawPicture (SSD1327ZB_Device* dev,
+                                  uint16_t xPos,
+                                  uint16_t yPos,
+                                  uint16_t width,
+                                  uint16_t height,
+                                  const uint8_t* picture,
+                                  GDL_PictureType pixelType)
+{
+    if ((pixelType != GDL_PICTURETYPE_1BIT) && (pixelType != GDL_PICTURETYPE_4BIT))
+        return GDL_ERRORS_WRONG_VALUE;
+
+    if (((xPos + width) > dev->gdl.width) || ((yPos + height) > dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if ((width == 0) || (height == 0))
+        return GDL_ERRORS_OK;
+
+    // Every source row is converted into the nibble order of the buffer,
+    // and then copied with or without the nibble shift
+    uint8_t row [((WARCOMEB_SSD1327ZB_WIDTH + 7)/8) * 4];
+
+    if (pixelType == GDL_PICTURETYPE_4BIT)
+    {
+        const uint16_t stride = (width + 1)/2;
+        for (uint16_t y = 0; y < height; ++y, picture += stride)
+        {
+            if (!SSD1327ZB_isRowInBuffer(dev,yPos+y)) continue;
+
+            for (uint16_t i = 0; i < stride; ++i)
+            {
+                row[i] = (uint8_t)(picture[i] << 4) | (picture[i] >> 4);
+            }
+            SSD1327ZB_copyNibbles(SSD1327ZB_getRow(dev,yPos+y),xPos,row,0,width);
+        }
+    }
+    else
+    {
+        const uint16_t stride = (width + 7)/8;
+        for (uint16_t y = 0; y < height; ++y, picture += stride)
+        {
+            if (!SSD1327ZB_isRowInBuffer(dev,yPos+y)) continue;
+
+            // Every source byte becomes four bytes of the buffer
+            uint8_t* dst = row;
+            for (uint16_t i = 0; i < stride; ++i)
+            {
+                const uint8_t* high = dev->pictureLut[picture[i] >> 4];
+                const uint8_t* low = dev->pictureLut[picture[i] & 0x0F];
+                *dst++ = high[0];
+                *dst++ = high[1];
+                *dst++ = low[0];
+                *dst++ = low[1];
+            }
+            SSD1327ZB_copyNibbles(SSD1327ZB_getRow(dev,yPos+y),xPos,row,0,width);
+        }
+    }
+
+    SSD1327ZB_markDirty(dev,xPos,xPos+width-1,yPos,yPos+height-1);
+    return GDL_ERRORS_OK;
+}
+
+/**
+ * 4x4 Bayer matrix, with thresholds from 0 to 15.
+ */
+static const uint8_t SSD1327ZB_bayer[4][4] =
+{
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 },
+};
+
+GDL_Errors SSD1327ZB_drawGrayPicture (SSD1327ZB_Device* dev,
+                                      uint16_t xPos,
+                                      uint16_t yPos,
+                                      uint16_t width,
+                                      uint16_t height,
+                                      const uint8_t* picture,
+                                      SSD1327ZB_Dither dither)
+{
+    if (dither > SSD1327ZB_DITHER_DIFFUSION)
+        return GDL_ERRORS_WRONG_VALUE;
+
+    if (((xPos + width) > dev->gdl.width) || ((yPos + height) > dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if ((width == 0) || (height == 0))
+        return GDL_ERRORS_OK;
+
+    // Every row is converted in the nibble order of the buffer and then
+    // copied, the last byte may hold a single pixel
+    uint8_t row [WARCOMEB_SSD1327ZB_WIDTH/2 + 1];
+    // Error of the next row, moved by one: errors[x+1] is for the pixel x
+    int16_t errors [WARCOMEB_SSD1327ZB_WIDTH + 2];
+    if (dither == SSD1327ZB_DITHER_DIFFUSION)
+        memset(errors,0,sizeof(errors));
+
+    for (uint16_t y = 0; y < height; ++y, picture += width)
+    {
+        const bool isInBuffer = SSD1327ZB_isRowInBuffer(dev,yPos+y);
+        // The error must cross also the rows out of the band
+        if (!isInBuffer && (dither != SSD1327ZB_DITHER_DIFFUSION)) continue;
+
+        row[width/2] = 0;
+
+        switch (dither)
+        {
+        case SSD1327ZB_DITHER_NONE:
+            for (uint16_t x = 0; x < width; x += 2)
+            {
+                uint8_t high = ((x + 1) < width) ? (picture[x + 1] & 0xF0) : 0;
+                row[x/2] = (picture[x] >> 4) | high;
+            }
+            break;
+
+        case SSD1327ZB_DITHER_ORDERED:
+        {
+            const uint8_t* threshold = SSD1327ZB_bayer[(yPos + y) & 0x03];
+            for (uint16_t x = 0; x < width; ++x)
+            {
+                // The threshold adds less than one level, that are 17 steps apart
+                uint16_t value = picture[x] + threshold[(xPos + x) & 0x03] + 1;
+                uint8_t level = (value * 241) >> 12;
+                if (x%2)
+                    row[x/2] |= (uint8_t)(level << 4);
+                else
+                    row[x/2] = level;
+            }
+        }
+            break;
+
+        default: // SSD1327ZB_DITHER_DIFFUSION
+        {
+            int16_t right = 0;                   // 7/16 for the next pixel
+            int16_t below = 0;  // 1/16 for the next row, from the last pixel
+            errors[0] = 0;
+            for (uint16_t x = 0; x < width; ++x)
+            {
+                int16_t value = picture[x] + right + errors[x + 1];
+                if (value < 0) value = 0;
+                if (value > 255) value = 255;
+
+                // Nearest of the 16 levels, that are 17 steps apart
+                uint8_t level = ((value + 8) * 241) >> 12;
+                int16_t error = value - (level * 17);
+
+                // The last part takes the rest, so no error is lost
+                right = (error * 7) / 16;
+                int16_t left = (error * 3) / 16;
+                int16_t down = (error * 5) / 16;
+                errors[x] += left;
+                errors[x + 1] = below + down;
+                below = error - right - left - down;
+
+                if (x%2)
+                    row[x/2] |= (uint8_t)(level << 4);
+                else
+                    row[x/2] = level;
+            }
+        }
+            break;
+        }
+
+        if (isInBuffer)
+            SSD1327ZB_copyNibbles(SSD1327ZB_getRow(dev,yPos+y),xPos,row,0,width);
+    }
+
+    SSD1327ZB_markDirty(dev,xPos,xPos+width-1,yPos,yPos+height-1);
+    return GDL_ERRORS_OK;
+}
+
+GDL_Errors SSD1327ZB_drawSpan (SSD1327ZB_Device* dev,
+                               uint8_t xPos,
+                               uint8_t yPos,
+                               uint16_t length,
+                               const uint8_t* colors)
+{
+    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if (length > (dev->gdl.width - xPos))
+        length = dev->gdl.width - xPos;
+    if (length == 0)
+        return GDL_ERRORS_OK;
+
+    SSD1327ZB_markDirty(dev,xPos,xPos+length-1,yPos,yPos);
+    if (!SSD1327ZB_isRowInBuffer(dev,yPos))
+        return GDL_ERRORS_OK;
+
+    uint8_t* pixel = SSD1327ZB_getRow(dev,yPos) + (xPos/2);
+    if (xPos%2)
+    {
+        *pixel = (uint8_t)(*colors++ << 4) | (*pixel & 0x0F);
+        pixel++;
+        length--;
+    }
+    // Two pixels for every byte
+    for (; length >= 2; length -= 2, colors += 2)
+    {
+        *pixel++ = (colors[0] & 0x0F) | (uint8_t)(colors[1] << 4);
+    }
+    if (length)
+        *pixel = (colors[0] & 0x0F) | (*pixel & 0xF0);
+
+    return GDL_ERRORS_OK;
+}
+
+void SSD1327ZB_drawPoints (SSD1327ZB_Device* dev,
+                           const SSD1327ZB_Point* points,
+                           uint16_t count)
+{
+    uint8_t* row = 0;
+    uint8_t rowPos = 0;
+    // The run of points on the current row, not yet marked dirty
+    uint8_t runStart = 0xFF, runStop = 0;
+
+    for (const SSD1327ZB_Point* point = points; point < (points + count); ++point)
+    {
+        if ((point->xPos >= dev->gdl.width) || (point->yPos >= dev->gdl.height))
+            continue;
+
+        if ((runStart <= runStop) && (point->yPos != rowPos))
+        {
+            SSD1327ZB_markDirty(dev,runStart,runStop,rowPos,rowPos);
+            runStart = 0xFF;
+            runStop = 0;
+        }
+        if (point->xPos < runStart) runStart = point->xPos;
+        if (point->xPos > runStop)  runStop  = point->xPos;
+
+        // The row is looked up only when it changes
+        if ((row == 0) || (point->yPos != rowPos))
+        {
+            rowPos = point->yPos;
+            row = (SSD1327ZB_isRowInBuffer(dev,rowPos)) ? SSD1327ZB_getRow(dev,rowPos) : 0;
+            if (row == 0) continue;
+        }
+
+        uint8_t* pixel = &row[point->xPos/2];
+        if (point->xPos%2)
+            *pixel = (uint8_t)(point->color << 4) | (*pixel & 0x0F);
+        else
+            *pixel = (point->color & 0x0F) | (*pixel & 0xF0);
+    }
+
+    if (runStart <= runStop)
+        SSD1327ZB_markDirty(dev,runStart,runStop,rowPos,rowPos);
+}
+
+#define SSD1327ZB_RASTER_LANES                   0x0F0F0F0FUL
+#define SSD1327ZB_RASTER_CARRY                   0x10101010UL
+#define SSD1327ZB_RASTER_ONES                    0x01010101UL
+
+/**
+ * The function apply an operation to the eight pixels of a word.
+ * The arithmetic operations work on even and odd pixels separately: every
+ * pixel is into its own byte, so the fifth bit hold its carry or borrow.
+ */
+static inline uint32_t SSD1327ZB_rasterWord (uint32_t value,
+                                             uint32_t operand,
+                                             SSD1327ZB_RasterOp op)
+{
+    switch (op)
+    {
+    case SSD1327ZB_RASTEROP_INVERT:
+        return ~value;
+    case SSD1327ZB_RASTEROP_AND:
+        return value & operand;
+    case SSD1327ZB_RASTEROP_OR:
+        return value | operand;
+    case SSD1327ZB_RASTEROP_XOR:
+        return value ^ operand;
+    default:
+        break;
+    }
+
+    uint32_t result = 0;
+    for (uint8_t shift = 0; shift <= 4; shift += 4)
     {
-        SSD1327ZB_sendData(dev,dev->buffer[i]);
+        uint32_t pixels = (value >> shift) & SSD1327ZB_RASTER_LANES;
+        uint32_t operands = (operand >> shift) & SSD1327ZB_RASTER_LANES;
+        uint32_t lanes;
+
+        switch (op)
+        {
+        case SSD1327ZB_RASTEROP_DIM:
+            // 16 + pixel - operand: the fifth bit is clear on underflow
+            lanes = (pixels | SSD1327ZB_RASTER_CARRY) - operands;
+            lanes &= ((lanes >> 4) & SSD1327ZB_RASTER_ONES) * 0x0F;
+            break;
+        case SSD1327ZB_RASTEROP_BRIGHTEN:
+            // The fifth bit is set on overflow
+            lanes = pixels + operands;
+            lanes |= ((lanes >> 4) & SSD1327ZB_RASTER_ONES) * 0x0F;
+            break;
+        default: // SSD1327ZB_RASTEROP_THRESHOLD
+            lanes = (pixels | SSD1327ZB_RASTER_CARRY) - operands;
+            lanes = ((lanes >> 4) & SSD1327ZB_RASTER_ONES) * 0x0F;
+            break;
+        }
+        result |= (lanes & SSD1327ZB_RASTER_LANES) << shift;
     }
+    return result;
 }
 
-void SSD1327ZB_flushPart (SSD1327ZB_Device* dev,
-                          uint8_t xStart,
-                          uint8_t xStop,
-                          uint8_t yStart,
-                          uint8_t yStop)
+/**
+ * The function apply an operation to a part of a row. The edges are
+ * changed only into the nibbles of the area, the inner part is processed
+ * a word at a time.
+ *
+ * @param[in] row The row of the buffer
+ * @param[in] mask The same row of the mask, 0 to use the constant operand
+ * @param[in] operand The operand repeated into all the nibbles
+ */
+static void SSD1327ZB_rasterRow (uint8_t* row,
+                                 const uint8_t* mask,
+                                 uint32_t operand,
+                                 uint8_t xStart,
+                                 uint8_t xStop,
+                                 SSD1327ZB_RasterOp op)
 {
-    // Set the part of the display where change the pixels
-    GDL_Errors error = SSD1327ZB_setBufferPosition(dev,xStart,xStop,yStart,yStop);
-    if (error != GDL_ERRORS_OK) return;
+    uint8_t i = xStart/2;
+    const uint8_t last = xStop/2;
+    uint8_t firstMask = (xStart%2) ? 0xF0 : 0xFF;
+    const uint8_t lastMask = (xStop%2) ? 0xFF : 0x0F;
 
-    uint8_t xStartHalf = xStart/2;
-    uint8_t xStopHalf = xStop/2;
-    uint8_t widthHalf = dev->gdl.width/2;
+    if (i == last) firstMask &= lastMask;
+    if ((firstMask != 0xFF) || (i == last))
+    {
+        uint8_t result = SSD1327ZB_rasterWord(row[i],(mask != 0) ? mask[i] : operand,op);
+        row[i] = (result & firstMask) | (row[i] & ~firstMask);
+        if (i == last) return;
+        i++;
+    }
 
-    for (uint8_t i = yStart; i <= yStop; i++)
+    const uint8_t stop = (lastMask != 0xFF) ? last : (last + 1);
+    for (; (i + sizeof(uint32_t)) <= stop; i += sizeof(uint32_t))
     {
-        for (uint8_t j = xStartHalf; j <= xStopHalf; j++)
+        uint32_t word;
+        memcpy(&word,&row[i],sizeof(uint32_t));
+        if (mask != 0) memcpy(&operand,&mask[i],sizeof(uint32_t));
+        word = SSD1327ZB_rasterWord(word,operand,op);
+        memcpy(&row[i],&word,sizeof(uint32_t));
+    }
+    for (; i < stop; ++i)
+    {
+        row[i] = SSD1327ZB_rasterWord(row[i],(mask != 0) ? mask[i] : operand,op);
+    }
+
+    if (lastMask != 0xFF)
+    {
+        uint8_t result = SSD1327ZB_rasterWord(row[last],(mask != 0) ? mask[last] : operand,op);
+        row[last] = (result & lastMask) | (row[last] & ~lastMask);
+    }
+}
+
+/**
+ * The function apply an operation to an area, with a constant operand or
+ * with a mask.
+ */
+static GDL_Errors SSD1327ZB_rasterArea (SSD1327ZB_Device* dev,
+                                       uint16_t xStart,
+                                       uint16_t yStart,
+                                       uint16_t width,
+                                       uint16_t height,
+                                       SSD1327ZB_RasterOp op,
+                                       uint32_t operand,
+                                       const uint8_t* mask)
+{
+    if (((xStart + width) > dev->gdl.width) || ((yStart + height) > dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if (op > SSD1327ZB_RASTEROP_THRESHOLD)
+        return GDL_ERRORS_WRONG_VALUE;
+
+    if ((width == 0) || (height == 0))
+        return GDL_ERRORS_OK;
+
+    const uint8_t xStop = xStart + width - 1;
+    uint8_t yFirst = yStart;
+    uint8_t yLast = yStart + height - 1;
+    SSD1327ZB_markDirty(dev,xStart,xStop,yFirst,yLast);
+    if (!SSD1327ZB_clipRows(dev,&yFirst,&yLast))
+        return GDL_ERRORS_OK;
+
+    const uint8_t widthHalf = dev->gdl.width/2;
+    for (uint8_t y = yFirst; y <= yLast; ++y)
+    {
+        SSD1327ZB_rasterRow(SSD1327ZB_getRow(dev,y),
+                            (mask != 0) ? &mask[y * widthHalf] : 0,
+                            operand,
+                            xStart,
+                            xStop,
+                            op);
+    }
+    return GDL_ERRORS_OK;
+}
+
+GDL_Errors SSD1327ZB_rasterOp (SSD1327ZB_Device* dev,
+                               uint16_t xStart,
+                               uint16_t yStart,
+                               uint16_t width,
+                               uint16_t height,
+                               SSD1327ZB_RasterOp op,
+                               SSD1327ZB_GrayScale value)
+{
+    uint32_t operand = (value & 0x0F) * 0x11111111UL;
+    return SSD1327ZB_rasterArea(dev,xStart,yStart,width,height,op,operand,0);
+}
+
+GDL_Errors SSD1327ZB_rasterMask (SSD1327ZB_Device* dev,
+                                 uint16_t xStart,
+                                 uint16_t yStart,
+                                 uint16_t width,
+                                 uint16_t height,
+                                 SSD1327ZB_RasterOp op,
+                                 const uint8_t* mask)
+{
+    return SSD1327ZB_rasterArea(dev,xStart,yStart,width,height,op,0,mask);
+}
+
+GDL_Errors SSD1327ZB_remapArea (SSD1327ZB_Device* dev,
+                                uint16_t xStart,
+                                uint16_t yStart,
+                                uint16_t width,
+                                uint16_t height,
+                                const uint8_t* table)
+{
+    if (((xStart + width) > dev->gdl.width) || ((yStart + height) > dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if ((width == 0) || (height == 0))
+        return GDL_ERRORS_OK;
+
+    const uint8_t xStop = xStart + width - 1;
+    uint8_t yFirst = yStart;
+    uint8_t yLast = yStart + height - 1;
+    SSD1327ZB_markDirty(dev,xStart,xStop,yFirst,yLast);
+    if (!SSD1327ZB_clipRows(dev,&yFirst,&yLast))
+        return GDL_ERRORS_OK;
+
+    // A table of whole bytes changes two pixels with a single access
+    uint8_t pairs [256];
+    for (uint16_t i = 0; i < 256; ++i)
+    {
+        pairs[i] = (table[i & 0x0F] & 0x0F) | (uint8_t)(table[i >> 4] << 4);
+    }
+
+    const uint8_t first = xStart/2;
+    const uint8_t last = xStop/2;
+    uint8_t firstMask = (xStart%2) ? 0xF0 : 0xFF;
+    uint8_t lastMask = (xStop%2) ? 0xFF : 0x0F;
+    if (first == last)
+    {
+        firstMask &= lastMask;
+        lastMask = firstMask;
+    }
+
+    for (uint8_t y = yFirst; y <= yLast; ++y)
+    {
+        uint8_t* row = SSD1327ZB_getRow(dev,y);
+
+        row[first] = (pairs[row[first]] & firstMask) | (row[first] & ~firstMask);
+        for (uint8_t i = first + 1; i < last; ++i)
         {
-            SSD1327ZB_sendData(dev,dev->buffer[j + (i * widthHalf)]);
+            row[i] = pairs[row[i]];
         }
+        if (last != first)
+            row[last] = (pairs[row[last]] & lastMask) | (row[last] & ~lastMask);
     }
+    return GDL_ERRORS_OK;
 }
 
-void SSD1327ZB_clear (SSD1327ZB_Device* dev)
+#if !defined WARCOMEB_SSD1327ZB_BANDED
+
+/**
+ * The function copy a run of pixels inside the same row, where source and
+ * destination can overlap.
+ */
+static void SSD1327ZB_moveNibbles (uint8_t* row,
+                                   uint8_t dstX,
+                                   uint8_t srcX,
+                                   uint8_t count)
 {
-    // Reset memory buffer
-    memset(dev->buffer, 0x00, WARCOMEB_SSD1327ZB_BUFFERDIMENSION);
-    // Flush the new buffer
-    SSD1327ZB_flush(dev);
+    if ((dstX%2) != (srcX%2))
+    {
+        // The shift would overwrite the source: copy it first
+        uint8_t temp [WARCOMEB_SSD1327ZB_WIDTH/2 + 1];
+        SSD1327ZB_copyNibbles(temp,srcX%2,row,srcX,count);
+        SSD1327ZB_copyNibbles(row,dstX,temp,srcX%2,count);
+        return;
+    }
+
+    // Same parity: the inner bytes are moved with memmove, the edge
+    // nibbles are read before anything is written
+    uint8_t first = 0;
+    uint8_t last = 0;
+    bool hasFirst = (dstX%2) ? TRUE : FALSE;
+    if (hasFirst)
+    {
+        first = row[srcX/2] >> 4;
+        srcX++;
+        dstX++;
+        count--;
+    }
+    bool hasLast = (count%2) ? TRUE : FALSE;
+    if (hasLast)
+        last = row[(srcX + count - 1)/2] & 0x0F;
+
+    memmove(&row[dstX/2],&row[srcX/2],count/2);
+
+    if (hasFirst)
+        row[(dstX - 1)/2] = (uint8_t)(first << 4) | (row[(dstX - 1)/2] & 0x0F);
+    if (hasLast)
+        row[(dstX + count - 1)/2] = last | (row[(dstX + count - 1)/2] & 0xF0);
 }
 
-void SSD1327ZB_drawLine (SSD1327ZB_Device* dev,
-                         uint8_t xStart,
-                         uint8_t yStart,
-                         uint8_t xStop,
-                         uint8_t yStop,
-                         SSD1327ZB_GrayScale color)
+GDL_Errors SSD1327ZB_copyRect (SSD1327ZB_Device* dev,
+                               uint8_t xSrc,
+                               uint8_t ySrc,
+                               uint8_t width,
+                               uint8_t height,
+                               uint8_t xDst,
+                               uint8_t yDst)
 {
-    GDL_drawLine(&(dev->gdl),xStart,yStart,xStop,yStop,(uint8_t)color);
+    if (((xSrc + width) > dev->gdl.width) || ((ySrc + height) > dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if (((xDst + width) > dev->gdl.width) || ((yDst + height) > dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if ((width == 0) || (height == 0) || ((xSrc == xDst) && (ySrc == yDst)))
+        return GDL_ERRORS_OK;
+
+    // Moving down the rows are copied from the bottom, so every source row
+    // is read before it is overwritten
+    const bool isDown = (yDst > ySrc) ? TRUE : FALSE;
+    for (uint8_t i = 0; i < height; ++i)
+    {
+        uint8_t row = (isDown) ? (height - 1 - i) : i;
+        uint8_t* dst = SSD1327ZB_getRow(dev,yDst + row);
+
+        if (yDst == ySrc)
+            SSD1327ZB_moveNibbles(dst,xDst,xSrc,width);
+        else
+            SSD1327ZB_copyNibbles(dst,xDst,SSD1327ZB_getRow(dev,ySrc + row),xSrc,width);
+    }
+
+    SSD1327ZB_markDirty(dev,xDst,xDst+width-1,yDst,yDst+height-1);
+    return GDL_ERRORS_OK;
 }
 
-void SSD1327ZB_drawHLine (SSD1327ZB_Device* dev,
-                          uint8_t xStart,
-                          uint8_t yStart,
-                          uint8_t width,
-                          SSD1327ZB_GrayScale color)
+GDL_Errors SSD1327ZB_moveRect (SSD1327ZB_Device* dev,
+                               uint8_t xSrc,
+                               uint8_t ySrc,
+                               uint8_t width,
+                               uint8_t height,
+                               uint8_t xDst,
+                               uint8_t yDst,
+                               SSD1327ZB_GrayScale background)
 {
-    SSD1327ZB_drawLine(dev,xStart,yStart,xStart+width,yStart,color);
+    GDL_Errors error = SSD1327ZB_copyRect(dev,xSrc,ySrc,width,height,xDst,yDst);
+    if ((error != GDL_ERRORS_OK) || (width == 0) || (height == 0))
+        return error;
+
+    const uint8_t xSrcStop = xSrc + width - 1;
+    const uint8_t ySrcStop = ySrc + height - 1;
+    const uint8_t xDstStop = xDst + width - 1;
+    const uint8_t yDstStop = yDst + height - 1;
+
+    if ((xDst > xSrcStop) || (xDstStop < xSrc) || (yDst > ySrcStop) || (yDstStop < ySrc))
+    {
+        // No overlap: all the source is uncovered
+        SSD1327ZB_fillArea(dev,xSrc,xSrcStop,ySrc,ySrcStop,background);
+        SSD1327ZB_markDirty(dev,xSrc,xSrcStop,ySrc,ySrcStop);
+        return GDL_ERRORS_OK;
+    }
+
+    // The rows of the source above or below the destination...
+    uint8_t yStart = ySrc;
+    uint8_t yStop = ySrcStop;
+    if (yDst > ySrc)
+    {
+        SSD1327ZB_fillArea(dev,xSrc,xSrcStop,ySrc,yDst-1,background);
+        SSD1327ZB_markDirty(dev,xSrc,xSrcStop,ySrc,yDst-1);
+        yStart = yDst;
+    }
+    else if (yDst < ySrc)
+    {
+        SSD1327ZB_fillArea(dev,xSrc,xSrcStop,yDstStop+1,ySrcStop,background);
+        SSD1327ZB_markDirty(dev,xSrc,xSrcStop,yDstStop+1,ySrcStop);
+        yStop = yDstStop;
+    }
+
+    // ...and the columns on its left or right side
+    if (xDst > xSrc)
+    {
+        SSD1327ZB_fillArea(dev,xSrc,xDst-1,yStart,yStop,background);
+        SSD1327ZB_markDirty(dev,xSrc,xDst-1,yStart,yStop);
+    }
+    else if (xDst < xSrc)
+    {
+        SSD1327ZB_fillArea(dev,xDstStop+1,xSrcStop,yStart,yStop,background);
+        SSD1327ZB_markDirty(dev,xDstStop+1,xSrcStop,yStart,yStop);
+    }
+
+    return GDL_ERRORS_OK;
 }
 
-void SSD1327ZB_drawVLine (SSD1327ZB_Device* dev,
-                          uint8_t xStart,
-                          uint8_t yStart,
-                          uint8_t height,
-                          SSD1327ZB_GrayScale color)
+#endif
+
+#define SSD1327ZB_RLE_LITERAL                    0x80 /**< Header of literal packets */
+#define SSD1327ZB_RLE_LONG_RUN                   0x07 /**< Run length in the next byte */
+
+/**
+ * State of the decoder of a compressed picture.
+ */
+typedef struct _SSD1327ZB_RleReader
+{
+    const uint8_t* data;                       /**< Next packet to be read */
+    uint16_t count;               /**< Pixels left into the current packet */
+    uint8_t level;                                  /**< Level of the run */
+    const uint8_t* literal;      /**< Pixels of a literal, 0 for a run */
+    uint16_t literalIndex;             /**< Next pixel into the literal */
+} SSD1327ZB_RleReader;
+
+/**
+ * The function read the header of the next packet.
+ */
+static void SSD1327ZB_rleNextPacket (SSD1327ZB_RleReader* reader)
 {
-    SSD1327ZB_drawLine(dev,xStart,yStart,xStart,yStart+height,color);
+    uint8_t header = *reader->data++;
+
+    if (header & SSD1327ZB_RLE_LITERAL)
+    {
+        uint8_t bytes = (header & 0x7F) + 1;
+        reader->count = (uint16_t)bytes * 2;
+        reader->literal = reader->data;
+        reader->literalIndex = 0;
+        reader->data += bytes;
+    }
+    else
+    {
+        reader->level = header >> 3;
+        reader->count = (header & SSD1327ZB_RLE_LONG_RUN) + 1;
+        if ((header & SSD1327ZB_RLE_LONG_RUN) == SSD1327ZB_RLE_LONG_RUN)
+            reader->count = *reader->data++ + 8;
+        reader->literal = 0;
+    }
 }
 
-void SSD1327ZB_drawRectangle (SSD1327ZB_Device* dev,
-                              uint16_t xStart,
-                              uint16_t yStart,
-                              uint16_t width,
-                              uint16_t height,
-                              SSD1327ZB_GrayScale color,
-                              bool isFill)
+/**
+ * The function return the next pixel of a compressed picture.
+ */
+static inline uint8_t SSD1327ZB_rleNextPixel (SSD1327ZB_RleReader* reader)
 {
-    GDL_drawRectangle(&(dev->gdl),xStart,yStart,width,height,(uint8_t)color,isFill);
+    if (reader->count == 0)
+        SSD1327ZB_rleNextPacket(reader);
+
+    reader->count--;
+    if (reader->literal == 0)
+        return reader->level;
+
+    uint8_t value = reader->literal[reader->literalIndex/2];
+    return (reader->literalIndex++ % 2) ? (value >> 4) : (value & 0x0F);
 }
 
-GDL_Errors SSD1327ZB_drawChar (SSD1327ZB_Device* dev,
-                               uint16_t xPos,
-                               uint16_t yPos,
-                               uint8_t c,
-                               SSD1327ZB_GrayScale color,
-                               SSD1327ZB_GrayScale background,
-                               uint8_t size)
+GDL_Errors SSD1327ZB_drawCompressedPicture (SSD1327ZB_Device* dev,
+                                            uint16_t xPos,
+                                            uint16_t yPos,
+                                            uint16_t width,
+                                            uint16_t height,
+                                            const uint8_t* data)
 {
-    return GDL_drawChar(&(dev->gdl),xPos,yPos,c,(uint8_t)color,(uint8_t)background,size);
+    if (((xPos + width) > dev->gdl.width) || ((yPos + height) > dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if ((width == 0) || (height == 0))
+        return GDL_ERRORS_OK;
+
+    SSD1327ZB_RleReader reader = {data, 0, 0, 0, 0};
+    uint16_t x = 0;
+    uint16_t y = 0;
+
+    // Every packet is split at the end of the rows, runs become spans and
+    // literals are copied as they are
+    while (y < height)
+    {
+        if (reader.count == 0)
+            SSD1327ZB_rleNextPacket(&reader);
+
+        uint16_t count = width - x;
+        if (reader.count < count)
+            count = reader.count;
+
+        if (SSD1327ZB_isRowInBuffer(dev,yPos+y))
+        {
+            uint8_t* row = SSD1327ZB_getRow(dev,yPos+y);
+            if (reader.literal == 0)
+                SSD1327ZB_fillSpan(row,xPos+x,xPos+x+count-1,reader.level);
+            else
+                SSD1327ZB_copyNibbles(row,xPos+x,reader.literal,reader.literalIndex,count);
+        }
+
+        reader.count -= count;
+        reader.literalIndex += count;
+        x += count;
+        if (x == width)
+        {
+            x = 0;
+            y++;
+        }
+    }
+
+    SSD1327ZB_markDirty(dev,xPos,xPos+width-1,yPos,yPos+height-1);
+    return GDL_ERRORS_OK;
 }
 
-GDL_Errors SSD1327ZB_drawPicture (SSD1327ZB_Device* dev,
-                                  uint16_t xPos,
-                                  uint16_t yPos,
-                                  uint16_t width,
-                                  uint16_t height,
-                                  const uint8_t* picture,
-                                  GDL_PictureType pixelType)
+GDL_Errors SSD1327ZB_sendCompressedPicture (SSD1327ZB_Device* dev,
+                                            uint16_t xPos,
+                                            uint16_t yPos,
+                                            uint16_t width,
+                                            uint16_t height,
+                                            const uint8_t* data)
 {
-    if ((pixelType != GDL_PICTURETYPE_1BIT) && (pixelType != GDL_PICTURETYPE_4BIT))
+    if (((xPos + width) > dev->gdl.width) || ((yPos + height) > dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if ((xPos%2) || (width%2))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if ((width == 0) || (height == 0))
+        return GDL_ERRORS_OK;
+
+    SSD1327ZB_Area area = {xPos, xPos+width-1, yPos, yPos+height-1};
+    SSD1327ZB_Area parts[2] = {area};
+    uint8_t count = 1;
+#if defined WARCOMEB_SSD1327ZB_SCROLL
+    // The display rows are moved by the scroll
+    count = SSD1327ZB_toBufferRows(dev,&area,parts);
+#endif
+
+    SSD1327ZB_RleReader reader = {data, 0, 0, 0, 0};
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+    const uint8_t widthHalf = dev->gdl.width/2;
+#endif
+
+    // Commands and pixels into a single transaction
+    SSD1327ZB_selectDevice(dev);
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        SSD1327ZB_setBufferPosition(dev,parts[i].xStart,parts[i].xStop,parts[i].yStart,parts[i].yStop);
+
+        SSD1327ZB_STATS_ADD(dataBytes,(uint16_t)(parts[i].yStop - parts[i].yStart + 1) * (width/2));
+
+        SSD1327ZB_beginTransfer(dev,TRUE);
+        for (uint8_t y = parts[i].yStart; y <= parts[i].yStop; ++y)
+        {
+            for (uint8_t j = parts[i].xStart/2; j <= parts[i].xStop/2; ++j)
+            {
+                uint8_t value = SSD1327ZB_rleNextPixel(&reader);
+                value |= (uint8_t)(SSD1327ZB_rleNextPixel(&reader) << 4);
+                SSD1327ZB_transferByte(dev,value);
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+                dev->shadow[(y * widthHalf) + j] = value;
+#endif
+            }
+        }
+        SSD1327ZB_endTransfer(dev);
+    }
+    SSD1327ZB_releaseDevice(dev);
+
+    return GDL_ERRORS_OK;
+}
+
+#if defined WARCOMEB_SSD1327ZB_SPRITES
+
+void SSD1327ZB_composeArea (SSD1327ZB_Device* dev,
+                            int16_t xStart,
+                            int16_t xStop,
+                            int16_t yStart,
+                            int16_t yStop)
+{
+    // Clip to the display
+    if (xStart < 0) xStart = 0;
+    if (yStart < 0) yStart = 0;
+    if (xStop >= dev->gdl.width) xStop = dev->gdl.width - 1;
+    if (yStop >= dev->gdl.height) yStop = dev->gdl.height - 1;
+    if ((xStart > xStop) || (yStart > yStop)) return;
+
+    SSD1327ZB_markDirty(dev,xStart,xStop,yStart,yStop);
+
+    uint8_t rowStart = yStart;
+    uint8_t rowStop = yStop;
+    if (!SSD1327ZB_clipRows(dev,&rowStart,&rowStop)) return;
+
+    // First the background...
+    const uint8_t widthHalf = dev->gdl.width/2;
+    for (uint8_t y = rowStart; y <= rowStop; ++y)
+    {
+        if (dev->background != 0)
+            SSD1327ZB_copyNibbles(SSD1327ZB_getRow(dev,y),xStart,
+                                  &dev->background[y * widthHalf],xStart,
+                                  xStop - xStart + 1);
+        else
+            SSD1327ZB_fillSpan(SSD1327ZB_getRow(dev,y),xStart,xStop,dev->backgroundColor);
+    }
+
+    // ...then the part of every sprite inside the area, from the bottom one
+    for (uint8_t i = 0; i < WARCOMEB_SSD1327ZB_SPRITES; ++i)
+    {
+        const SSD1327ZB_Sprite* sprite = &dev->sprite[i];
+        if (!sprite->isVisible || (sprite->pixels == 0)) continue;
+
+        int16_t left = (sprite->xPos > xStart) ? sprite->xPos : xStart;
+        int16_t right = sprite->xPos + sprite->width - 1;
+        if (right > xStop) right = xStop;
+        int16_t top = (sprite->yPos > rowStart) ? sprite->yPos : rowStart;
+        int16_t bottom = sprite->yPos + sprite->height - 1;
+        if (bottom > rowStop) bottom = rowStop;
+        if ((left > right) || (top > bottom)) continue;
+
+        const uint16_t stride = (sprite->width + 1)/2;
+        for (int16_t y = top; y <= bottom; ++y)
+        {
+            const uint8_t* src = &sprite->pixels[(y - sprite->yPos) * stride];
+            uint8_t* row = SSD1327ZB_getRow(dev,y);
+            for (int16_t x = left; x <= right; ++x)
+            {
+                // Into the sprite the left pixel is the high nibble
+                uint8_t sx = x - sprite->xPos;
+                uint8_t color = (sx%2) ? (src[sx/2] & 0x0F) : (src[sx/2] >> 4);
+                if (color == sprite->transparent) continue;
+
+                uint8_t* pixel = &row[x/2];
+                if (x%2)
+                    *pixel = (uint8_t)(color << 4) | (*pixel & 0x0F);
+                else
+                    *pixel = color | (*pixel & 0xF0);
+            }
+        }
+    }
+}
+
+/**
+ * The function draw again the area of a sprite.
+ */
+static void SSD1327ZB_composeSprite (SSD1327ZB_Device* dev, const SSD1327ZB_Sprite* sprite)
+{
+    if ((sprite->width == 0) || (sprite->height == 0)) return;
+
+    SSD1327ZB_composeArea(dev,
+                          sprite->xPos,
+                          sprite->xPos + sprite->width - 1,
+                          sprite->yPos,
+                          sprite->yPos + sprite->height - 1);
+}
+
+void SSD1327ZB_setBackground (SSD1327ZB_Device* dev,
+                              const uint8_t* background,
+                              SSD1327ZB_GrayScale color)
+{
+    dev->background = background;
+    dev->backgroundColor = color;
+
+    SSD1327ZB_composeArea(dev,0,dev->gdl.width-1,0,dev->gdl.height-1);
+}
+
+GDL_Errors SSD1327ZB_setSprite (SSD1327ZB_Device* dev,
+                                uint8_t id,
+                                const uint8_t* pixels,
+                                uint8_t width,
+                                uint8_t height,
+                                uint8_t transparent)
+{
+    if (id >= WARCOMEB_SSD1327ZB_SPRITES)
+        return GDL_ERRORS_WRONG_VALUE;
+
+    SSD1327ZB_Sprite* sprite = &dev->sprite[id];
+
+    // The old picture can be bigger than the new one
+    bool isVisible = sprite->isVisible;
+    sprite->isVisible = FALSE;
+    if (isVisible) SSD1327ZB_composeSprite(dev,sprite);
+
+    sprite->pixels = pixels;
+    sprite->width = width;
+    sprite->height = height;
+    sprite->transparent = transparent;
+    sprite->isVisible = isVisible;
+    if (isVisible) SSD1327ZB_composeSprite(dev,sprite);
+
+    return GDL_ERRORS_OK;
+}
+
+GDL_Errors SSD1327ZB_moveSprite (SSD1327ZB_Device* dev,
+                                 uint8_t id,
+                                 int16_t xPos,
+                                 int16_t yPos)
+{
+    if (id >= WARCOMEB_SSD1327ZB_SPRITES)
+        return GDL_ERRORS_WRONG_VALUE;
+
+    SSD1327ZB_Sprite* sprite = &dev->sprite[id];
+    if ((sprite->xPos == xPos) && (sprite->yPos == yPos))
+        return GDL_ERRORS_OK;
+
+    int16_t oldX = sprite->xPos;
+    int16_t oldY = sprite->yPos;
+    sprite->xPos = xPos;
+    sprite->yPos = yPos;
+
+    if (!sprite->isVisible || (sprite->width == 0) || (sprite->height == 0))
+        return GDL_ERRORS_OK;
+
+    int16_t width = sprite->width;
+    int16_t height = sprite->height;
+    int16_t dx = (xPos > oldX) ? (xPos - oldX) : (oldX - xPos);
+    int16_t dy = (yPos > oldY) ? (yPos - oldY) : (oldY - yPos);
+
+    if (((int32_t)(width + dx) * (height + dy)) <= ((int32_t)2 * width * height))
+    {
+        // Small moves: the union of the two areas is smaller than both
+        SSD1327ZB_composeArea(dev,
+                              (xPos < oldX) ? xPos : oldX,
+                              ((xPos > oldX) ? xPos : oldX) + width - 1,
+                              (yPos < oldY) ? yPos : oldY,
+                              ((yPos > oldY) ? yPos : oldY) + height - 1);
+    }
+    else
+    {
+        SSD1327ZB_composeArea(dev,oldX,oldX+width-1,oldY,oldY+height-1);
+        SSD1327ZB_composeSprite(dev,sprite);
+    }
+
+    return GDL_ERRORS_OK;
+}
+
+GDL_Errors SSD1327ZB_showSprite (SSD1327ZB_Device* dev,
+                                 uint8_t id,
+                                 bool isVisible)
+{
+    if (id >= WARCOMEB_SSD1327ZB_SPRITES)
         return GDL_ERRORS_WRONG_VALUE;
 
-    return GDL_drawPicture(&(dev->gdl),xPos,yPos,width,height,picture,pixelType);
+    SSD1327ZB_Sprite* sprite = &dev->sprite[id];
+    if (sprite->isVisible == isVisible)
+        return GDL_ERRORS_OK;
+
+    sprite->isVisible = isVisible;
+    SSD1327ZB_composeSprite(dev,sprite);
+
+    return GDL_ERRORS_OK;
 }
+
+#endif
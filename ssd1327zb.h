@@ -48,6 +48,15 @@
 #include "board.h"
 #endif
 
+#if defined WARCOMEB_SSD1327ZB_EMULATOR
+#include "ssd1327zb_emulator.h"
+#endif
+
+/*
+ * Default 7-bit I2C address of the display (SA0 pin low).
+ */
+#define WARCOMEB_SSD1327ZB_I2C_ADDRESS         0x3C
+
 #if !defined(WARCOMEB_SSD1327ZB_HEIGHT) | !defined(WARCOMEB_SSD1327ZB_WIDTH)
 #error "You must define height and width of display!"
 #else
@@ -63,6 +72,27 @@
 #error "The width must be between 16 and 128!"
 #endif
 
+/*
+ * The user can define the number of dirty areas tracked for each device.
+ * When the list is full the areas are merged together.
+ *     #define WARCOMEB_SSD1327ZB_DIRTY_AREAS    xx
+ */
+#ifndef WARCOMEB_SSD1327ZB_DIRTY_AREAS
+#define WARCOMEB_SSD1327ZB_DIRTY_AREAS 4
+#endif
+
+#if (WARCOMEB_SSD1327ZB_DIRTY_AREAS < 1)
+#error "The number of dirty areas must be at least 1!"
+#endif
+
+/*
+ * With the parallel bus the user can enable the write of the data lines
+ * with the set and clear registers of their port (see portMapper):
+ *     #define WARCOMEB_SSD1327ZB_FAST_PORT
+ * Every device holds the bits of the port for the values of the two
+ * nibbles of a byte: 128 bytes of RAM.
+ */
+
 /**
  * A usefull enum that define all the possbile color for each pixel.
  */
@@ -91,29 +121,393 @@ typedef enum _SSD1327ZB_Product
 	SSD1327ZB_PRODUCT_RAYSTAR_REX128128B   = 0x0001 | GDL_MODELTYPE_SSD1327ZB,
 } SSD1327ZB_Product;
 
+#if defined WARCOMEB_GDL_PARALLEL && defined WARCOMEB_SSD1327ZB_FAST_PORT
+/**
+ * Callback used to discover where a data line is mapped into the
+ * microcontroller GPIO ports.
+ *
+ * @param[in] pin The pin to be described
+ * @param[out] setRegister The register that drive high the written bits
+ * @param[out] clearRegister The register that drive low the written bits
+ * @param[out] bit The position of the pin into the port
+ * @return TRUE if the pin has been described, FALSE otherwise.
+ */
+typedef bool (*SSD1327ZB_PortMapper) (Gpio_Pins pin,
+                                      volatile uint32_t** setRegister,
+                                      volatile uint32_t** clearRegister,
+                                      uint8_t* bit);
+#endif
+
+/*
+ * The user can enable a cache of pre-rendered glyphs defining its size in
+ * bytes. Every glyph uses a slot sized for the biggest glyph allowed:
+ *     #define WARCOMEB_SSD1327ZB_GLYPH_CACHE_SIZE   xx
+ *     #define WARCOMEB_SSD1327ZB_GLYPH_MAX_WIDTH    xx
+ *     #define WARCOMEB_SSD1327ZB_GLYPH_MAX_HEIGHT   xx
+ * Glyphs bigger than the slot are drawn through GDL as before.
+ */
+#if defined WARCOMEB_SSD1327ZB_GLYPH_CACHE_SIZE
+
+#ifndef WARCOMEB_SSD1327ZB_GLYPH_MAX_WIDTH
+#define WARCOMEB_SSD1327ZB_GLYPH_MAX_WIDTH     12
+#endif
+
+#ifndef WARCOMEB_SSD1327ZB_GLYPH_MAX_HEIGHT
+#define WARCOMEB_SSD1327ZB_GLYPH_MAX_HEIGHT    16
+#endif
+
+#define WARCOMEB_SSD1327ZB_GLYPH_STRIDE        ((WARCOMEB_SSD1327ZB_GLYPH_MAX_WIDTH+1)/2)
+#define WARCOMEB_SSD1327ZB_GLYPH_SLOT_SIZE     (WARCOMEB_SSD1327ZB_GLYPH_STRIDE*WARCOMEB_SSD1327ZB_GLYPH_MAX_HEIGHT)
+#define WARCOMEB_SSD1327ZB_GLYPH_SLOTS         (WARCOMEB_SSD1327ZB_GLYPH_CACHE_SIZE/WARCOMEB_SSD1327ZB_GLYPH_SLOT_SIZE)
+
+#if (WARCOMEB_SSD1327ZB_GLYPH_SLOTS < 1)
+#error "The glyph cache must hold at least one glyph!"
+#endif
+
+/**
+ * Description of a pre-rendered glyph into the cache.
+ */
+typedef struct _SSD1327ZB_Glyph
+{
+    uint8_t c;                                         /**< The character */
+    uint8_t size;                             /**< The requested font size */
+    uint8_t colors;    /**< Foreground (high nibble) and background colors */
+    const void* font;     /**< Custom font used to render it, 0 for the default */
+    uint8_t width;                               /**< Rendered width, 0 if the slot is empty */
+    uint8_t height;                                    /**< Rendered height */
+    uint16_t lastUse;                        /**< Used for LRU eviction */
+} SSD1327ZB_Glyph;
+
+#endif
+
+/*
+ * The user can reduce the RAM used by the device with a buffer that holds
+ * only a band of rows: the screen is drawn band by band by
+ * SSD1327ZB_render. The band can be internal, with the number of rows:
+ *     #define WARCOMEB_SSD1327ZB_BAND_ROWS      xx
+ * or provided by the user (fields buffer and bufferSize of the device, to
+ * be set before SSD1327ZB_init), with any size multiple of a row:
+ *     #define WARCOMEB_SSD1327ZB_EXTERNAL_BUFFER
+ */
+#if defined WARCOMEB_SSD1327ZB_BAND_ROWS || defined WARCOMEB_SSD1327ZB_EXTERNAL_BUFFER
+#define WARCOMEB_SSD1327ZB_BANDED
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_BAND_ROWS && defined WARCOMEB_SSD1327ZB_EXTERNAL_BUFFER
+#error "Choose between internal band and external buffer!"
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_BAND_ROWS && ((WARCOMEB_SSD1327ZB_BAND_ROWS < 1) | (WARCOMEB_SSD1327ZB_BAND_ROWS > WARCOMEB_SSD1327ZB_HEIGHT))
+#error "The band must be between 1 row and the height of the display!"
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_BANDED && (defined WARCOMEB_SSD1327ZB_SCROLL || defined WARCOMEB_SSD1327ZB_SHADOW)
+#error "Scroll and shadow memory need the whole frame into the buffer!"
+#endif
+
+/*
+ * The user can keep a copy of the data sent to the display, so that only the
+ * changed bytes are sent by SSD1327ZB_flushDiff:
+ *     #define WARCOMEB_SSD1327ZB_SHADOW
+ */
+
+/*
+ * The user can enable the vertical scroll of the display with the start line
+ * command. The buffer becomes a ring of rows, so the drawing functions keep
+ * using the visible coordinates:
+ *     #define WARCOMEB_SSD1327ZB_SCROLL
+ */
+#if defined WARCOMEB_SSD1327ZB_SCROLL && (WARCOMEB_SSD1327ZB_HEIGHT != 128)
+#error "The scroll needs a display with 128 rows!"
+#endif
+
+/*
+ * The user can drive displays of different sizes with the same library,
+ * for example several panels on the same parallel bus with their own chip
+ * select. The fields gdl.width, gdl.height, buffer and bufferSize of every
+ * device are set by the user before SSD1327ZB_init: the buffer holds
+ * gdl.width/2 bytes for every row of the display (or of the band with
+ * WARCOMEB_SSD1327ZB_EXTERNAL_BUFFER). A size of 0 selects the biggest
+ * display and an odd width is rounded down; SSD1327ZB_init returns an
+ * error for a display bigger than the biggest one, narrower than two
+ * columns or with a buffer too small.
+ *     #define WARCOMEB_SSD1327ZB_MULTI
+ * WARCOMEB_SSD1327ZB_HEIGHT and WARCOMEB_SSD1327ZB_WIDTH become the size of
+ * the biggest display, the shadow memory is sized for it.
+ */
+#if defined WARCOMEB_SSD1327ZB_MULTI && defined WARCOMEB_SSD1327ZB_BAND_ROWS
+#error "With displays of different sizes the band must be an external buffer!"
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_MULTI && defined WARCOMEB_SSD1327ZB_SCROLL
+#error "The scroll needs displays with 128 rows!"
+#endif
+
+/*
+ * A display smaller than the display memory (128x128 pixels) can be wired
+ * to a part of it, from the first column and row selected by:
+ *     #define WARCOMEB_SSD1327ZB_X_OFFSET       xx
+ *     #define WARCOMEB_SSD1327ZB_Y_OFFSET       xx
+ * For example a display 96 columns wide on the middle of the memory has
+ * an x offset of 16. With WARCOMEB_SSD1327ZB_MULTI the offsets are the
+ * fields xOffset and yOffset of every device, set by the user before
+ * SSD1327ZB_init like the size. An odd x offset is rounded down.
+ */
+#if !defined WARCOMEB_SSD1327ZB_X_OFFSET
+#define WARCOMEB_SSD1327ZB_X_OFFSET            0
+#endif
+
+#if !defined WARCOMEB_SSD1327ZB_Y_OFFSET
+#define WARCOMEB_SSD1327ZB_Y_OFFSET            0
+#endif
+
+#if ((WARCOMEB_SSD1327ZB_X_OFFSET + WARCOMEB_SSD1327ZB_WIDTH) > 128) | ((WARCOMEB_SSD1327ZB_Y_OFFSET + WARCOMEB_SSD1327ZB_HEIGHT) > 128)
+#error "The display with its offsets must be inside the display memory!"
+#endif
+
+/**
+ * Direction of the horizontal scroll made by the controller.
+ */
+typedef enum _SSD1327ZB_ScrollDirection
+{
+    SSD1327ZB_SCROLLDIRECTION_RIGHT = 0x26,
+    SSD1327ZB_SCROLLDIRECTION_LEFT  = 0x27,
+} SSD1327ZB_ScrollDirection;
+
+/**
+ * Number of entries of the gray scale table: GS0 is always 0, the entries
+ * are the pulse widths of the levels from GS1 to GS15.
+ */
+#define SSD1327ZB_GRAYTABLE_SIZE               15
+
+/**
+ * A rectangular part of the display. All the bounds are inclusive.
+ */
+typedef struct _SSD1327ZB_Area
+{
+    uint8_t xStart;
+    uint8_t xStop;
+    uint8_t yStart;
+    uint8_t yStop;
+} SSD1327ZB_Area;
+
+/*
+ * The user can count the work done by the driver, to find the screens that
+ * are too slow. Without this define the counters do not exist and cost
+ * nothing:
+ *     #define WARCOMEB_SSD1327ZB_STATS
+ */
+#if defined WARCOMEB_SSD1327ZB_STATS
+
+/**
+ * Callback that return the current time, in any unit chosen by the user
+ * (for example microseconds). It is used to measure the flushes.
+ */
+typedef uint32_t (*SSD1327ZB_TimeCallback) (void);
+
+/**
+ * Counters of the work done by the driver since the last reset.
+ * The pixel counters hold the pixels written one by one, by
+ * SSD1327ZB_drawPixel and by the drawings done through GDL. The lines,
+ * rectangles, spans and pictures drawn by the driver write whole bytes
+ * and are not counted.
+ */
+typedef struct _SSD1327ZB_Stats
+{
+    uint32_t commandBytes;       /**< Command bytes, arguments included */
+    uint32_t dataBytes;                    /**< Display data bytes sent */
+    uint32_t flushes;                     /**< Calls of SSD1327ZB_flush */
+    uint32_t flushParts;              /**< Calls of SSD1327ZB_flushPart */
+    uint32_t flushDiffs;              /**< Calls of SSD1327ZB_flushDiff */
+    uint32_t flushSteps;              /**< Calls of SSD1327ZB_flushStep */
+    uint32_t flushGroups;  /**< Flushes of the device by SSD1327ZB_flushGroup */
+    uint32_t pixels;                  /**< Pixels written one by one */
+    uint32_t redundantPixels;     /**< Pixels written with the same value */
+    uint32_t flushTime;          /**< Total time spent into the flushes */
+    uint32_t flushTimeMax;                  /**< Time of the slowest flush */
+} SSD1327ZB_Stats;
+
+#endif
+
+/*
+ * The user can compose the buffer from a background and a pool of sprites,
+ * defining the number of sprites:
+ *     #define WARCOMEB_SSD1327ZB_SPRITES    xx
+ * Moving a sprite redraw only its old and new position.
+ */
+#if defined WARCOMEB_SSD1327ZB_SPRITES
+
+#if (WARCOMEB_SSD1327ZB_SPRITES < 1) || (WARCOMEB_SSD1327ZB_SPRITES > 255)
+#error "The sprites must be from 1 to 255!"
+#endif
+
+/**
+ * Value of the color key of sprites without transparent pixels.
+ */
+#define SSD1327ZB_SPRITE_OPAQUE                0xFF
+
+/**
+ * A picture drawn over the background. The sprites with a greater index are
+ * drawn over the others.
+ */
+typedef struct _SSD1327ZB_Sprite
+{
+    const uint8_t* pixels;  /**< 4 bit pixels, same format of drawPicture */
+    int16_t xPos;                /**< Left side, it can be out of display */
+    int16_t yPos;                 /**< Top side, it can be out of display */
+    uint8_t width;
+    uint8_t height;
+    uint8_t transparent;       /**< Color key, SSD1327ZB_SPRITE_OPAQUE if none */
+    bool isVisible;
+} SSD1327ZB_Sprite;
+
+#endif
+
 typedef struct SSD1327ZB_Device
 {
     GDL_Device gdl;                         /**< Common part for each device */
 
-#if defined WARCOMEB_GDL_PARALLEL
+#if defined WARCOMEB_SSD1327ZB_EMULATOR
+
+    SSD1327ZB_Emulator* emulator;      /**< Controller model used as bus */
+    bool isDataTransfer;           /**< Kind of the current transfer */
+
+#elif defined WARCOMEB_GDL_PARALLEL
+
+#if defined WARCOMEB_SSD1327ZB_FAST_PORT
+    /**
+     * Optional callback that describe the data lines. When all the lines
+     * are into the same port, every byte is written with two register
+     * accesses instead of eight GPIO calls.
+     */
+    SSD1327ZB_PortMapper portMapper;
+
+    volatile uint32_t* portSet;       /**< Set register of the data port */
+    volatile uint32_t* portClear;   /**< Clear register of the data port */
+    uint32_t portDataMask;              /**< Bits used by the data lines */
+    uint32_t portLowMask [16];  /**< Bits to set for the low nibble values */
+    uint32_t portHighMask [16];/**< Bits to set for the high nibble values */
+#endif
 
 #elif defined WARCOMEB_GDL_I2C
 
+    Iic_DeviceHandle iicDev;          /**< I2C peripheral, already initialized */
+    uint8_t address;                         /**< 7-bit address of the display */
     Gpio_Pins rstPin;            /**< Reset pin used for start-up the display */
+    bool isDataTransfer;  /**< A data stream is open into the held transfer */
 
 #elif defined WARCOMEB_GDL_SPI
 
+    Spi_DeviceHandle spiDev;          /**< SPI peripheral, already initialized */
+    Gpio_Pins csPin;                                      /**< Chip select pin */
+    Gpio_Pins dcPin;                                  /**< Data/command pin */
+    Gpio_Pins rstPin;            /**< Reset pin used for start-up the display */
+
 #endif
 
+#if defined WARCOMEB_SSD1327ZB_EXTERNAL_BUFFER || defined WARCOMEB_SSD1327ZB_MULTI
+    /** Buffer to store display data, provided by the user */
+    uint8_t* buffer;
+    /** Dimension in bytes of the user buffer */
+    uint16_t bufferSize;
+#elif defined WARCOMEB_SSD1327ZB_BAND_ROWS
+    /** Buffer to store a band of display data */
+    uint8_t buffer [WARCOMEB_SSD1327ZB_WIDTH/2*WARCOMEB_SSD1327ZB_BAND_ROWS];
+#else
     /** Buffer to store display data */
     uint8_t buffer [WARCOMEB_SSD1327ZB_BUFFERDIMENSION];
+#endif
+
+    uint8_t xOffset;       /**< First column of the display memory used */
+    uint8_t yOffset;          /**< First row of the display memory used */
+
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    uint8_t bandStart;               /**< First row of the current band */
+    uint8_t bandRows;                     /**< Number of rows of a band */
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+    /** Copy of the display memory, as it was sent by the last flushes */
+    uint8_t shadow [WARCOMEB_SSD1327ZB_BUFFERDIMENSION];
+    /** FALSE until the whole display has been sent at least once */
+    bool isShadowValid;
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_SCROLL
+    /** Row of the buffer shown at the top of the display */
+    uint8_t scrollOffset;
+#endif
+
+    /** Areas of the buffer changed since the last flush */
+    SSD1327ZB_Area dirty [WARCOMEB_SSD1327ZB_DIRTY_AREAS];
+    /** Number of valid areas into the dirty list */
+    uint8_t dirtyCount;
+
+    /** Areas being sent by the incremental flush, in rows of the buffer */
+    SSD1327ZB_Area flushQueue [2*WARCOMEB_SSD1327ZB_DIRTY_AREAS];
+    uint8_t flushQueueCount;
+    uint8_t flushArea;                         /**< Area being sent */
+    uint8_t flushRow;                    /**< Next row of the area */
+    bool isFlushWindowOpen;   /**< The display pointer is at flushRow */
+
+    /** The display is kept selected between the transfers */
+    bool isSelected;
+
+    uint16_t frameInterval;       /**< Minimum time between frames, in ms */
+    uint16_t frameBudget;          /**< Maximum bytes sent into a frame */
+    uint32_t frameStart;                /**< Time of the last frame, in ms */
+
+    /** Bounding box of the pixels drawn by the current GDL primitive */
+    SSD1327ZB_Area drawBox;
+
+    /** Two packed bytes for every nibble of a 1 bit picture */
+    uint8_t pictureLut [16][2];
+
+    uint8_t contrast;                   /**< Last contrast sent to display */
+    uint8_t contrastFrom;                    /**< Contrast at fade start */
+    uint8_t contrastTo;                           /**< Contrast at fade end */
+    uint16_t contrastStep;           /**< Steps done by the contrast fade */
+    uint16_t contrastSteps;                  /**< Length of the contrast fade */
+
+    /** Gray scale table GS1..GS15 last sent to the display */
+    uint8_t grayTable [SSD1327ZB_GRAYTABLE_SIZE];
+    uint8_t grayFrom [SSD1327ZB_GRAYTABLE_SIZE];      /**< Table at fade start */
+    uint8_t grayTo [SSD1327ZB_GRAYTABLE_SIZE];          /**< Table at fade end */
+    uint16_t grayStep;                   /**< Steps done by the table fade */
+    uint16_t graySteps;                      /**< Length of the table fade */
+
+#if defined WARCOMEB_SSD1327ZB_GLYPH_CACHE_SIZE
+    SSD1327ZB_Glyph glyph [WARCOMEB_SSD1327ZB_GLYPH_SLOTS];
+    /** Nibble-packed pixels of every glyph, row by row */
+    uint8_t glyphData [WARCOMEB_SSD1327ZB_GLYPH_SLOTS][WARCOMEB_SSD1327ZB_GLYPH_SLOT_SIZE];
+    uint16_t glyphClock;                       /**< Counter used for LRU */
+    int16_t glyphCapture;       /**< Slot being rendered, -1 if nothing */
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_SPRITES
+    SSD1327ZB_Sprite sprite [WARCOMEB_SSD1327ZB_SPRITES];
+    /** Whole screen picture in the buffer format, 0 for a plain color */
+    const uint8_t* background;
+    uint8_t backgroundColor;
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_STATS
+    SSD1327ZB_Stats stats;
+    /** Optional clock used to measure the flushes, set by the user */
+    SSD1327ZB_TimeCallback getTime;
+#endif
 
 } SSD1327ZB_Device;
 
 /**
+ * The function initialize the device and the display.
  *
+ * @param[in] dev The handle of the device
+ * @return GDL_ERRORS_WRONG_VALUE if the size of the display is wrong, the
+ *         display with its offsets exceeds the display memory or the user
+ *         buffer is too small, GDL_ERRORS_OK otherwise.
  */
-void SSD1327ZB_init (SSD1327ZB_Device* dev);
+GDL_Errors SSD1327ZB_init (SSD1327ZB_Device* dev);
 
 /**
  *
@@ -129,6 +523,28 @@ GDL_Errors SSD1327ZB_drawPixel (SSD1327ZB_Device* dev,
                                 uint8_t yPos,
 							    SSD1327ZB_GrayScale color);
 
+/**
+ * Callback that draw the whole screen, used by SSD1327ZB_render.
+ */
+typedef void (*SSD1327ZB_RenderCallback) (SSD1327ZB_Device* dev, void* context);
+
+/**
+ * The function draw and send the whole screen. The buffer is cleared, the
+ * callback draw the screen and then the buffer is sent.
+ * When the buffer holds only a band of rows, this is repeated for every
+ * band: all the drawing functions are clipped to the current band, so the
+ * callback must draw the same screen every time it is called. At the end
+ * the last band of the display stays into the buffer and selected, so the
+ * drawings made after the render change only that band.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] callback The function that draw the screen
+ * @param[in] context A pointer passed to the callback
+ */
+void SSD1327ZB_render (SSD1327ZB_Device* dev,
+                       SSD1327ZB_RenderCallback callback,
+                       void* context);
+
 /**
  * The function print a line in the selected position with the selected
  * color.
@@ -181,6 +597,8 @@ void SSD1327ZB_drawVLine (SSD1327ZB_Device* dev,
 
 /**
  * The function draw a rectangle. It can be fill or not.
+ * A filled rectangle is clipped to the display once and written directly
+ * into the buffer, two pixels per byte.
  *
  * @param[in] dev The handle of the device
  * @param[in] xStart The starting x position
@@ -198,6 +616,186 @@ void SSD1327ZB_drawRectangle (SSD1327ZB_Device* dev,
 							  SSD1327ZB_GrayScale color,
                               bool isFill);
 
+/**
+ * Operations made by SSD1327ZB_rasterOp and SSD1327ZB_rasterMask on every
+ * pixel of an area. The operand is a gray level, the same for all the
+ * pixels or taken from a mask picture.
+ */
+typedef enum _SSD1327ZB_RasterOp
+{
+    SSD1327ZB_RASTEROP_INVERT    = 0, /**< 15 - pixel, the operand is unused */
+    SSD1327ZB_RASTEROP_AND       = 1,                 /**< pixel & operand */
+    SSD1327ZB_RASTEROP_OR        = 2,                 /**< pixel | operand */
+    SSD1327ZB_RASTEROP_XOR       = 3,                 /**< pixel ^ operand */
+    SSD1327ZB_RASTEROP_DIM       = 4,   /**< pixel - operand, at least 0 */
+    SSD1327ZB_RASTEROP_BRIGHTEN  = 5,  /**< pixel + operand, at most 15 */
+    SSD1327ZB_RASTEROP_THRESHOLD = 6, /**< 15 if pixel >= operand, else 0 */
+} SSD1327ZB_RasterOp;
+
+/**
+ * The function apply an operation to all the pixels of a rectangle, with
+ * the same operand for every pixel. The buffer is processed a word (eight
+ * pixels) at a time. The area is marked dirty.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The starting x position
+ * @param[in] yStart The starting y position
+ * @param[in] width The width of the rectangle
+ * @param[in] height The height of the rectangle
+ * @param[in] op The operation
+ * @param[in] value The operand
+ * @return GDL_ERRORS_WRONG_POSITION if the rectangle exceeds the display,
+ *         GDL_ERRORS_WRONG_VALUE if the operation is wrong,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_rasterOp (SSD1327ZB_Device* dev,
+                               uint16_t xStart,
+                               uint16_t yStart,
+                               uint16_t width,
+                               uint16_t height,
+                               SSD1327ZB_RasterOp op,
+                               SSD1327ZB_GrayScale value);
+
+/**
+ * The function apply an operation to all the pixels of a rectangle, the
+ * operand of every pixel is the pixel in the same position of the mask.
+ * The mask is a picture as big as the display, in the format of the buffer
+ * (left pixel into the low nibble).
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The starting x position
+ * @param[in] yStart The starting y position
+ * @param[in] width The width of the rectangle
+ * @param[in] height The height of the rectangle
+ * @param[in] op The operation
+ * @param[in] mask The operands
+ * @return GDL_ERRORS_WRONG_POSITION if the rectangle exceeds the display,
+ *         GDL_ERRORS_WRONG_VALUE if the operation is wrong,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_rasterMask (SSD1327ZB_Device* dev,
+                                 uint16_t xStart,
+                                 uint16_t yStart,
+                                 uint16_t width,
+                                 uint16_t height,
+                                 SSD1327ZB_RasterOp op,
+                                 const uint8_t* mask);
+
+/**
+ * The function change every pixel of a rectangle through a table of 16
+ * gray levels. The area is marked dirty.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The starting x position
+ * @param[in] yStart The starting y position
+ * @param[in] width The width of the rectangle
+ * @param[in] height The height of the rectangle
+ * @param[in] table The new level of every level
+ * @return GDL_ERRORS_WRONG_POSITION if the rectangle exceeds the display,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_remapArea (SSD1327ZB_Device* dev,
+                                uint16_t xStart,
+                                uint16_t yStart,
+                                uint16_t width,
+                                uint16_t height,
+                                const uint8_t* table);
+
+/**
+ * A pixel of a list drawn by SSD1327ZB_drawPoints.
+ */
+typedef struct _SSD1327ZB_Point
+{
+    uint8_t xPos;
+    uint8_t yPos;
+    uint8_t color;                         /**< Gray level, from 0 to 15 */
+} SSD1327ZB_Point;
+
+/**
+ * The function draw a horizontal run of pixels, one byte for every pixel
+ * (only the 4 less significant bits are used). The pixels are packed two
+ * for every byte of the buffer, the run is clipped to the display once.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xPos The x position of the first pixel
+ * @param[in] yPos The y position of the run
+ * @param[in] length The number of pixels
+ * @param[in] colors The gray levels of the pixels
+ * @return GDL_ERRORS_WRONG_POSITION if the run starts out of the display,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_drawSpan (SSD1327ZB_Device* dev,
+                               uint8_t xPos,
+                               uint8_t yPos,
+                               uint16_t length,
+                               const uint8_t* colors);
+
+/**
+ * The function draw a list of pixels. The points out of the display are
+ * skipped. The points of a row are marked dirty as a single run, and the
+ * runs are merged by SSD1327ZB_markDirty only when it is cheaper.
+ * Lists ordered by row are the fastest, because the row is looked up only
+ * when it changes.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] points The list of pixels
+ * @param[in] count The number of pixels into the list
+ */
+void SSD1327ZB_drawPoints (SSD1327ZB_Device* dev,
+                           const SSD1327ZB_Point* points,
+                           uint16_t count);
+
+#if !defined WARCOMEB_SSD1327ZB_BANDED
+/**
+ * The function copy a rectangle of pixels inside the buffer. Source and
+ * destination can overlap. The destination is marked dirty.
+ * Not available when the buffer holds only a band of rows.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xSrc The x position of the source
+ * @param[in] ySrc The y position of the source
+ * @param[in] width The width of the rectangle
+ * @param[in] height The height of the rectangle
+ * @param[in] xDst The x position of the destination
+ * @param[in] yDst The y position of the destination
+ * @return GDL_ERRORS_WRONG_POSITION if source or destination exceed the
+ *         display, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_copyRect (SSD1327ZB_Device* dev,
+                               uint8_t xSrc,
+                               uint8_t ySrc,
+                               uint8_t width,
+                               uint8_t height,
+                               uint8_t xDst,
+                               uint8_t yDst);
+
+/**
+ * The function move a rectangle of pixels inside the buffer: the part of
+ * the source not covered by the destination is filled with the background
+ * color. Source and destination areas are marked dirty.
+ * Not available when the buffer holds only a band of rows.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xSrc The x position of the source
+ * @param[in] ySrc The y position of the source
+ * @param[in] width The width of the rectangle
+ * @param[in] height The height of the rectangle
+ * @param[in] xDst The x position of the destination
+ * @param[in] yDst The y position of the destination
+ * @param[in] background The color of the uncovered pixels
+ * @return GDL_ERRORS_WRONG_POSITION if source or destination exceed the
+ *         display, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_moveRect (SSD1327ZB_Device* dev,
+                               uint8_t xSrc,
+                               uint8_t ySrc,
+                               uint8_t width,
+                               uint8_t height,
+                               uint8_t xDst,
+                               uint8_t yDst,
+                               SSD1327ZB_GrayScale background);
+#endif
+
 /**
  * The function print a char in the selected position with the selected
  * color and size.
@@ -221,12 +819,50 @@ GDL_Errors SSD1327ZB_drawChar (SSD1327ZB_Device* dev,
                                SSD1327ZB_GrayScale background,
                                uint8_t size);
 
+/**
+ * The function print a string in the selected position with the selected
+ * color and size. When the glyph cache is enabled, every character is
+ * copied from the cache row by row, otherwise it is drawn by GDL. Only
+ * whole characters are drawn: the string stops at the first character
+ * that does not fit into the display.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xPos The x position of the first char
+ * @param[in] yPos The y position of the first char
+ * @param[in] text The null-terminated string to be draw
+ * @param[in] color The foreground color of the chars
+ * @param[in] background The background color of the chars
+ * @param[in] size The size for the chars, if 0 use default dimension
+ * @return GDL_ERRORS_WRONG_POSITION if the string start out of the display,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_drawString (SSD1327ZB_Device* dev,
+                                 uint16_t xPos,
+                                 uint16_t yPos,
+                                 const char* text,
+                                 SSD1327ZB_GrayScale color,
+                                 SSD1327ZB_GrayScale background,
+                                 uint8_t size);
+
+#if defined WARCOMEB_SSD1327ZB_GLYPH_CACHE_SIZE
+/**
+ * The function empty the glyph cache. The glyphs are kept apart by the font
+ * used to render them, so it is needed only when a font is changed in place.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1327ZB_clearGlyphCache (SSD1327ZB_Device* dev);
+#endif
+
 /**
  * The function print a picture from an array of pixel, in the selected
  * position.
  * Every pixel can be described from 1 or 4 because this OLED driver accept
  * only 16-level of color.
  * The starting point is the top-left corner of the picture.
+ * Every row of the picture starts on a new byte: with 4 bit the left pixel
+ * is the high nibble, with 1 bit the left pixel is the most significant bit
+ * and it is drawn with the colors chosen by SSD1327ZB_setPictureColors.
  *
  * @param[in] dev The handle of the device
  * @param[in] xPos The x position
@@ -248,12 +884,167 @@ GDL_Errors SSD1327ZB_drawPicture (SSD1327ZB_Device* dev,
                                   const uint8_t* picture,
                                   GDL_PictureType pixelType);
 
+/**
+ * How 8 bit pictures are converted to the 16 levels of the display.
+ */
+typedef enum _SSD1327ZB_Dither
+{
+    SSD1327ZB_DITHER_NONE      = 0,   /**< The 4 less significant bits are dropped */
+    SSD1327ZB_DITHER_ORDERED   = 1,               /**< 4x4 Bayer matrix */
+    SSD1327ZB_DITHER_DIFFUSION = 2,    /**< Floyd-Steinberg error diffusion */
+} SSD1327ZB_Dither;
+
+/**
+ * The function print a picture with 8 bit for every pixel, converted to
+ * the 16 levels of the display row by row: the error diffusion keeps only
+ * the error of one row.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xPos The x position
+ * @param[in] yPos The y position
+ * @param[in] width The picture dimension along the x axis
+ * @param[in] height The picture dimension along the y axis
+ * @param[in] picture The pixels, one byte for every pixel and row by row
+ * @param[in] dither The conversion method
+ * @return GDL_ERRORS_WRONG_POSITION if the picture exceeds the display,
+ *         GDL_ERRORS_WRONG_VALUE if the conversion method is wrong,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_drawGrayPicture (SSD1327ZB_Device* dev,
+                                      uint16_t xPos,
+                                      uint16_t yPos,
+                                      uint16_t width,
+                                      uint16_t height,
+                                      const uint8_t* picture,
+                                      SSD1327ZB_Dither dither);
+
+/*
+ * Compressed 4 bit pictures, made by tools/ssd1327zb_rle.py.
+ * The pixels are read row by row as a stream of packets, a packet can
+ * continue on the next row. Every packet starts with a header byte:
+ *     0LLLLNNN  run of the level LLLL: NNN from 0 to 6 means NNN+1 pixels,
+ *               NNN equal to 7 means that the next byte n is followed and
+ *               the run is n+8 pixels long
+ *     1NNNNNNN  NNNNNNN+1 bytes of literal pixels follow, two pixels for
+ *               every byte with the left pixel into the low nibble
+ * The picture ends after width*height pixels.
+ */
+
+/**
+ * The function decode a compressed picture into the buffer, in the selected
+ * position. The picture is decoded while it is copied: no decompressed
+ * copy is needed.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xPos The x position
+ * @param[in] yPos The y position
+ * @param[in] width The picture dimension along the x axis
+ * @param[in] height The picture dimension along the y axis
+ * @param[in] data The compressed picture
+ * @return GDL_ERRORS_WRONG_POSITION if the picture exceeds the display,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_drawCompressedPicture (SSD1327ZB_Device* dev,
+                                            uint16_t xPos,
+                                            uint16_t yPos,
+                                            uint16_t width,
+                                            uint16_t height,
+                                            const uint8_t* data);
+
+/**
+ * The function decode a compressed picture straight to the display,
+ * without changing the buffer: it is useful for splash screens that are
+ * shown before the buffer is used. The next flush of the same area send
+ * the content of the buffer again.
+ * The picture must start and end on whole column pairs.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xPos The x position, must be even
+ * @param[in] yPos The y position
+ * @param[in] width The picture dimension along the x axis, must be even
+ * @param[in] height The picture dimension along the y axis
+ * @param[in] data The compressed picture
+ * @return GDL_ERRORS_WRONG_POSITION if the picture exceeds the display or
+ *         it is not aligned to the column pairs, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_sendCompressedPicture (SSD1327ZB_Device* dev,
+                                            uint16_t xPos,
+                                            uint16_t yPos,
+                                            uint16_t width,
+                                            uint16_t height,
+                                            const uint8_t* data);
+
+/**
+ * The function select the colors used to draw 1 bit pictures.
+ * The default colors are SSD1327ZB_GRAYSCALE_15 and SSD1327ZB_GRAYSCALE_0.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] foreground The color of the bits set to 1
+ * @param[in] background The color of the bits set to 0
+ */
+void SSD1327ZB_setPictureColors (SSD1327ZB_Device* dev,
+                                 SSD1327ZB_GrayScale foreground,
+                                 SSD1327ZB_GrayScale background);
+
 /**
  * @param[in] dev The handle of the device
  * @param[in] value The 256 contrast steps from 00h to FFh
  */
 void SSD1327ZB_setContrast (SSD1327ZB_Device* dev, uint8_t value);
 
+/**
+ * The function send a custom gray scale table, so all the 16 levels of the
+ * buffer are shown with new brightness without changing the buffer.
+ * The controller needs strictly increasing values, from GS1 to GS15.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] table The SSD1327ZB_GRAYTABLE_SIZE pulse widths, from GS1 to GS15
+ */
+void SSD1327ZB_setGrayTable (SSD1327ZB_Device* dev, const uint8_t* table);
+
+/**
+ * The function restore the default linear gray scale table.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1327ZB_setLinearGrayTable (SSD1327ZB_Device* dev);
+
+/**
+ * The function start a fade of the contrast, from the current value to the
+ * selected one. The fade is made by SSD1327ZB_fadeTick: every call send
+ * the next step, with only two command bytes.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] value The contrast at the end of the fade
+ * @param[in] steps The number of ticks of the fade, 0 to set it at once
+ */
+void SSD1327ZB_fadeContrast (SSD1327ZB_Device* dev,
+                             uint8_t value,
+                             uint16_t steps);
+
+/**
+ * The function start a fade of the gray scale table, from the current table
+ * to the selected one. Every tick of the fade send 16 command bytes.
+ * When both tables are strictly increasing, every step is too.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] table The table at the end of the fade, from GS1 to GS15
+ * @param[in] steps The number of ticks of the fade, 0 to set it at once
+ */
+void SSD1327ZB_fadeGrayTable (SSD1327ZB_Device* dev,
+                              const uint8_t* table,
+                              uint16_t steps);
+
+/**
+ * The function make a step of the running fades. It never waits: the user
+ * call it at the rate of the fade, for example from the main loop or from
+ * a timer.
+ *
+ * @param[in] dev The handle of the device
+ * @return TRUE while a fade is running, FALSE when all the fades are done.
+ */
+bool SSD1327ZB_fadeTick (SSD1327ZB_Device* dev);
+
 /**
  *
  *
@@ -268,6 +1059,54 @@ void SSD1327ZB_setContrast (SSD1327ZB_Device* dev, uint8_t value);
  */
 //void SSD1306_normalDisplay (SSD1327ZB_Device* dev);
 
+#if defined WARCOMEB_SSD1327ZB_SCROLL
+/**
+ * The function scroll the content of the display changing the start line,
+ * without sending the buffer again. The rows exposed by the scroll are
+ * filled with the background color and marked dirty: they must be drawn
+ * and then sent with SSD1327ZB_flushDirty.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] lines The number of rows: positive values move the content up,
+ *                  negative values move the content down
+ * @param[in] background The color of the exposed rows
+ */
+void SSD1327ZB_scroll (SSD1327ZB_Device* dev,
+                       int16_t lines,
+                       SSD1327ZB_GrayScale background);
+#endif
+
+/**
+ * The function start the continuous horizontal scroll of a part of the
+ * display, made by the controller without any other transfer.
+ * The content of the display memory must be sent again after the scroll
+ * is stopped. With WARCOMEB_SSD1327ZB_SHADOW the next SSD1327ZB_flushDiff
+ * sends the whole frame.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] direction The direction of the scroll
+ * @param[in] xStart The x start position, rounded to column pairs
+ * @param[in] xStop The x stop position, rounded to column pairs
+ * @param[in] yStart The first row to be scrolled
+ * @param[in] yStop The last row to be scrolled
+ * @param[in] interval The time between two steps, from 0 to 7 as defined
+ *                     by the datasheet
+ */
+void SSD1327ZB_startHorizontalScroll (SSD1327ZB_Device* dev,
+                                      SSD1327ZB_ScrollDirection direction,
+                                      uint8_t xStart,
+                                      uint8_t xStop,
+                                      uint8_t yStart,
+                                      uint8_t yStop,
+                                      uint8_t interval);
+
+/**
+ * The function stop the horizontal scroll.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1327ZB_stopHorizontalScroll (SSD1327ZB_Device* dev);
+
 /**
  * This function clear the display setting off all pixel
  *
@@ -276,7 +1115,8 @@ void SSD1327ZB_setContrast (SSD1327ZB_Device* dev, uint8_t value);
 void SSD1327ZB_clear (SSD1327ZB_Device* dev);
 
 /**
- *
+ * The function send the whole buffer. When the buffer holds a band of rows,
+ * only the current band is sent.
  *
  * @param[in] dev The handle of the device
  */
@@ -297,5 +1137,214 @@ void SSD1327ZB_flushPart (SSD1327ZB_Device* dev,
                           uint8_t yStart,
                           uint8_t yStop);
 
+/**
+ * The function start an incremental flush of the dirty areas. The areas
+ * are sent by SSD1327ZB_flushStep a piece at a time, so the caller is never
+ * blocked for the whole transfer.
+ * While the flush is active every drawing function keep marking its area
+ * dirty: the changes into rows already sent are sent by the next flush.
+ * If a flush is already active, the function does nothing.
+ * When the buffer holds only a band of rows, SSD1327ZB_render and
+ * SSD1327ZB_clear change the band and drop the active flush.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1327ZB_flushBegin (SSD1327ZB_Device* dev);
+
+/**
+ * The function send the next rows of an incremental flush. Only whole rows
+ * are sent, but at least one row is sent every call.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] budget The maximum number of bytes (commands included)
+ * @return The number of bytes sent.
+ */
+uint16_t SSD1327ZB_flushStep (SSD1327ZB_Device* dev, uint16_t budget);
+
+/**
+ * @param[in] dev The handle of the device
+ * @return TRUE while an incremental flush is active.
+ */
+bool SSD1327ZB_flushBusy (SSD1327ZB_Device* dev);
+
+/**
+ * The function configure the flush scheduler: the producers only draw (or
+ * mark areas dirty) and SSD1327ZB_frameTick send the changes, at most
+ * once for every frame.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] fps The maximum number of frames per second, 0 for no limit
+ * @param[in] budget The maximum bytes sent into a frame, 0 for no limit
+ */
+void SSD1327ZB_setFrameRate (SSD1327ZB_Device* dev,
+                             uint8_t fps,
+                             uint16_t budget);
+
+/**
+ * The function send a frame when the frame interval is elapsed. The dirty
+ * areas are merged and sent with an incremental flush, the cheapest areas
+ * first: what does not fit into the budget of the frame is sent by the
+ * next frames, before the areas marked after it started.
+ * It never waits, the user call it from the main loop.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] now The current time, in milliseconds
+ * @return TRUE if a frame has been sent, FALSE otherwise.
+ */
+bool SSD1327ZB_frameTick (SSD1327ZB_Device* dev, uint32_t now);
+
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+/**
+ * The function compare the buffer with the copy of the display memory and
+ * send only the changed bytes. Every row is split into runs of changed
+ * column pairs: close runs are sent as a single span when the new window
+ * costs more than the unchanged bytes between them. Rows with the same span
+ * are sent into a single window.
+ * The first call send the whole buffer.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1327ZB_flushDiff (SSD1327ZB_Device* dev);
+#endif
+
+/**
+ * The function add an area to the list of the changed parts of the buffer.
+ * The bounds are clipped to the display and the x bounds are rounded to
+ * whole column pairs, because every byte of the buffer holds two pixels.
+ * The new area is merged with the stored ones when sending a single window
+ * is cheaper than sending them separately.
+ * All the drawing functions of this library call it, the user must call it
+ * only when the buffer is changed through GDL functions directly.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The starting x position
+ * @param[in] xStop The ending x position
+ * @param[in] yStart The starting y position
+ * @param[in] yStop The ending y position
+ */
+void SSD1327ZB_markDirty (SSD1327ZB_Device* dev,
+                          uint16_t xStart,
+                          uint16_t xStop,
+                          uint16_t yStart,
+                          uint16_t yStop);
+
+/**
+ * The function send to the display only the areas changed since the last
+ * flush, and then empty the list of dirty areas.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1327ZB_flushDirty (SSD1327ZB_Device* dev);
+
+/**
+ * The function send the areas changed since the last flush of a group of
+ * displays sharing the same bus, and then empty their lists of dirty areas.
+ * Every display is selected only once and all its windows are sent into a
+ * single transaction: the function saves only the chip select toggles (on
+ * I2C the start condition and the address) between the windows. The
+ * displays are still updated one after the other, the transfers don't
+ * overlap.
+ * It can be used also with a single display.
+ *
+ * @param[in] group The handles of the devices
+ * @param[in] count The number of devices
+ */
+void SSD1327ZB_flushGroup (SSD1327ZB_Device** group, uint8_t count);
+
+#if defined WARCOMEB_SSD1327ZB_STATS
+/**
+ * The function reset all the counters of the device.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1327ZB_resetStats (SSD1327ZB_Device* dev);
+
+/**
+ * The function copy the current value of the counters.
+ *
+ * @param[in] dev The handle of the device
+ * @param[out] stats The copy of the counters
+ */
+void SSD1327ZB_getStats (SSD1327ZB_Device* dev, SSD1327ZB_Stats* stats);
+#endif
+
+#if defined WARCOMEB_SSD1327ZB_SPRITES
+/**
+ * The function select the background of the sprites and draw the whole
+ * screen again.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] background A picture as big as the display, in the format of
+ *                       the buffer (left pixel into the low nibble), or 0
+ * @param[in] color The color used when the picture is 0
+ */
+void SSD1327ZB_setBackground (SSD1327ZB_Device* dev,
+                              const uint8_t* background,
+                              SSD1327ZB_GrayScale color);
+
+/**
+ * The function change the picture of a sprite and redraw it.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] id The index of the sprite
+ * @param[in] pixels The 4 bit pixels, as for SSD1327ZB_drawPicture
+ * @param[in] width The sprite dimension along the x axis
+ * @param[in] height The sprite dimension along the y axis
+ * @param[in] transparent The color not drawn, SSD1327ZB_SPRITE_OPAQUE to
+ *                        draw all the pixels
+ * @return GDL_ERRORS_WRONG_VALUE if the index is wrong, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_setSprite (SSD1327ZB_Device* dev,
+                                uint8_t id,
+                                const uint8_t* pixels,
+                                uint8_t width,
+                                uint8_t height,
+                                uint8_t transparent);
+
+/**
+ * The function move a sprite: only the old and the new area of the sprite
+ * are drawn again and marked dirty.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] id The index of the sprite
+ * @param[in] xPos The new left side, it can be out of the display
+ * @param[in] yPos The new top side, it can be out of the display
+ * @return GDL_ERRORS_WRONG_VALUE if the index is wrong, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_moveSprite (SSD1327ZB_Device* dev,
+                                 uint8_t id,
+                                 int16_t xPos,
+                                 int16_t yPos);
+
+/**
+ * The function show or hide a sprite.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] id The index of the sprite
+ * @param[in] isVisible TRUE to show the sprite
+ * @return GDL_ERRORS_WRONG_VALUE if the index is wrong, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1327ZB_showSprite (SSD1327ZB_Device* dev,
+                                 uint8_t id,
+                                 bool isVisible);
+
+/**
+ * The function draw again an area from the background and the visible
+ * sprites, and mark it dirty. It must be called when the background
+ * picture is changed.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The starting x position
+ * @param[in] xStop The ending x position
+ * @param[in] yStart The starting y position
+ * @param[in] yStop The ending y position
+ */
+void SSD1327ZB_composeArea (SSD1327ZB_Device* dev,
+                            int16_t xStart,
+                            int16_t xStop,
+                            int16_t yStart,
+                            int16_t yStop);
+#endif
+
 #endif /* __WARCOMEB_SSD1327ZB_H */
 
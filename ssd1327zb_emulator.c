@@ -0,0 +1,332 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include "ssd1327zb_emulator.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#define SSD1327ZB_EMULATOR_REMAP_COLUMN          0x01
+#define SSD1327ZB_EMULATOR_REMAP_NIBBLE          0x02
+#define SSD1327ZB_EMULATOR_REMAP_ADDR_INCREMENT  0x04
+#define SSD1327ZB_EMULATOR_REMAP_COM             0x10
+
+/**
+ * The function return the number of arguments of a command.
+ */
+static uint8_t SSD1327ZB_emulatorArguments (uint8_t command)
+{
+    switch (command)
+    {
+    case 0x15: // Set column address
+    case 0x75: // Set row address
+        return 2;
+    case 0x26: // Horizontal scroll setup
+    case 0x27:
+        return 6;
+    case 0x81: // Set contrast
+    case 0xA0: // Set remap
+    case 0xA1: // Set start line
+    case 0xA2: // Set display offset
+    case 0xA8: // Set multiplex ratio
+    case 0xAB: // Function selection
+    case 0xB1: // Set phase length
+    case 0xB3: // Set clock
+    case 0xB6: // Set second pre-charge period
+    case 0xBC: // Set pre-charge voltage
+    case 0xBE: // Set VCOMH
+    case 0xD5: // Function selection B
+    case 0xFD: // Command lock
+        return 1;
+    case 0xB8: // Custom gray scale table
+        return 15;
+    default:
+        return 0;
+    }
+}
+
+static uint8_t SSD1327ZB_emulatorIsKnown (uint8_t command)
+{
+    switch (command)
+    {
+    case 0x15: case 0x26: case 0x27: case 0x2E: case 0x2F: case 0x75:
+    case 0x81: case 0xA0: case 0xA1: case 0xA2: case 0xA4: case 0xA5:
+    case 0xA6: case 0xA7: case 0xA8: case 0xAB: case 0xAE: case 0xAF:
+    case 0xB1: case 0xB3: case 0xB6: case 0xB8: case 0xB9: case 0xBC:
+    case 0xBE: case 0xD5: case 0xE3: case 0xFD:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static void SSD1327ZB_emulatorLinearTable (SSD1327ZB_Emulator* emu)
+{
+    for (uint8_t i = 0; i < 15; ++i)
+    {
+        emu->grayTable[i] = (i + 1) * 2;
+    }
+}
+
+/**
+ * The function apply a command when all its arguments are received.
+ */
+static void SSD1327ZB_emulatorExecute (SSD1327ZB_Emulator* emu)
+{
+    uint8_t* arg = emu->arguments;
+
+    switch (emu->command)
+    {
+    case 0x15:
+        emu->columnStart = arg[0] & 0x3F;
+        emu->columnStop  = arg[1] & 0x3F;
+        emu->column      = emu->columnStart;
+        break;
+    case 0x75:
+        emu->rowStart = arg[0] & 0x7F;
+        emu->rowStop  = arg[1] & 0x7F;
+        emu->row      = emu->rowStart;
+        break;
+    case 0x26:
+    case 0x27:
+        // Only the setup is stored, the scrolling is not animated
+        break;
+    case 0x2E:
+        emu->isScrolling = 0;
+        break;
+    case 0x2F:
+        emu->isScrolling = 1;
+        break;
+    case 0x81:
+        emu->contrast = arg[0];
+        break;
+    case 0xA0:
+        emu->remap = arg[0];
+        break;
+    case 0xA1:
+        emu->startLine = arg[0] & 0x7F;
+        break;
+    case 0xA2:
+        emu->displayOffset = arg[0] & 0x7F;
+        break;
+    case 0xA4:
+        emu->mode = SSD1327ZB_EMULATORMODE_NORMAL;
+        break;
+    case 0xA5:
+        emu->mode = SSD1327ZB_EMULATORMODE_ALLON;
+        break;
+    case 0xA6:
+        emu->mode = SSD1327ZB_EMULATORMODE_ALLOFF;
+        break;
+    case 0xA7:
+        emu->mode = SSD1327ZB_EMULATORMODE_INVERSE;
+        break;
+    case 0xAE:
+        emu->isOn = 0;
+        break;
+    case 0xAF:
+        emu->isOn = 1;
+        break;
+    case 0xB8:
+        memcpy(emu->grayTable,arg,15);
+        break;
+    case 0xB9:
+        SSD1327ZB_emulatorLinearTable(emu);
+        break;
+    default:
+        // Timing and analog settings do not change the image
+        break;
+    }
+}
+
+void SSD1327ZB_emulatorInit (SSD1327ZB_Emulator* emu)
+{
+    memset(emu,0,sizeof(SSD1327ZB_Emulator));
+
+    emu->columnStop = SSD1327ZB_EMULATOR_COLUMNS - 1;
+    emu->rowStop = SSD1327ZB_EMULATOR_ROWS - 1;
+    emu->contrast = 0x7F;
+    SSD1327ZB_emulatorLinearTable(emu);
+}
+
+void SSD1327ZB_emulatorResetCounters (SSD1327ZB_Emulator* emu)
+{
+    memset(&emu->counters,0,sizeof(SSD1327ZB_EmulatorCounters));
+}
+
+void SSD1327ZB_emulatorTransaction (SSD1327ZB_Emulator* emu)
+{
+    emu->counters.transactions++;
+}
+
+void SSD1327ZB_emulatorCommand (SSD1327ZB_Emulator* emu, uint8_t value)
+{
+    emu->counters.commandBytes++;
+
+    if (emu->argumentsCount < emu->argumentsExpected)
+    {
+        // Argument of the current command
+        emu->arguments[emu->argumentsCount++] = value;
+    }
+    else
+    {
+        emu->counters.commands++;
+        if (!SSD1327ZB_emulatorIsKnown(value))
+            emu->counters.unknownCommands++;
+
+        emu->command = value;
+        emu->argumentsCount = 0;
+        emu->argumentsExpected = SSD1327ZB_emulatorArguments(value);
+    }
+
+    if (emu->argumentsCount == emu->argumentsExpected)
+    {
+        SSD1327ZB_emulatorExecute(emu);
+        // Ready for a new command
+        emu->argumentsExpected = 0;
+        emu->argumentsCount = 0;
+    }
+}
+
+void SSD1327ZB_emulatorData (SSD1327ZB_Emulator* emu, uint8_t value)
+{
+    emu->counters.dataBytes++;
+
+    uint8_t* cell = &emu->gddram[emu->row][emu->column];
+    if (*cell == value)
+        emu->counters.redundantBytes++;
+    *cell = value;
+
+    if (emu->remap & SSD1327ZB_EMULATOR_REMAP_ADDR_INCREMENT)
+    {
+        // Vertical address increment
+        if (emu->row >= emu->rowStop)
+        {
+            emu->row = emu->rowStart;
+            emu->column = (emu->column >= emu->columnStop) ? emu->columnStart : emu->column + 1;
+        }
+        else
+        {
+            emu->row++;
+        }
+    }
+    else
+    {
+        // Horizontal address increment
+        if (emu->column >= emu->columnStop)
+        {
+            emu->column = emu->columnStart;
+            emu->row = (emu->row >= emu->rowStop) ? emu->rowStart : emu->row + 1;
+        }
+        else
+        {
+            emu->column++;
+        }
+    }
+}
+
+uint8_t SSD1327ZB_emulatorGetPixel (const SSD1327ZB_Emulator* emu,
+                                    uint8_t xPos,
+                                    uint8_t yPos)
+{
+    switch (emu->mode)
+    {
+    case SSD1327ZB_EMULATORMODE_ALLON:
+        return 15;
+    case SSD1327ZB_EMULATORMODE_ALLOFF:
+        return 0;
+    default:
+        break;
+    }
+
+    if (!emu->isOn) return 0;
+
+    xPos %= (SSD1327ZB_EMULATOR_COLUMNS * 2);
+    yPos %= SSD1327ZB_EMULATOR_ROWS;
+
+    if (emu->remap & SSD1327ZB_EMULATOR_REMAP_COLUMN)
+        xPos = (SSD1327ZB_EMULATOR_COLUMNS * 2) - 1 - xPos;
+    if (emu->remap & SSD1327ZB_EMULATOR_REMAP_COM)
+        yPos = SSD1327ZB_EMULATOR_ROWS - 1 - yPos;
+
+    uint8_t row = (yPos + emu->startLine + emu->displayOffset) % SSD1327ZB_EMULATOR_ROWS;
+    uint8_t value = emu->gddram[row][xPos/2];
+
+    // Without nibble remap the low nibble is the left pixel
+    uint8_t high = (xPos % 2) ^ ((emu->remap & SSD1327ZB_EMULATOR_REMAP_NIBBLE) ? 1 : 0);
+    uint8_t level = high ? (value >> 4) : (value & 0x0F);
+
+    if (emu->mode == SSD1327ZB_EMULATORMODE_INVERSE)
+        level = 15 - level;
+
+    return level;
+}
+
+int SSD1327ZB_emulatorSavePgm (const SSD1327ZB_Emulator* emu,
+                               const char* filename)
+{
+    FILE* file = fopen(filename,"wb");
+    if (file == NULL) return -1;
+
+    fprintf(file,"P5\n%d %d\n15\n",SSD1327ZB_EMULATOR_COLUMNS * 2,SSD1327ZB_EMULATOR_ROWS);
+    for (uint16_t y = 0; y < SSD1327ZB_EMULATOR_ROWS; ++y)
+    {
+        for (uint16_t x = 0; x < (SSD1327ZB_EMULATOR_COLUMNS * 2); ++x)
+        {
+            fputc(SSD1327ZB_emulatorGetPixel(emu,x,y),file);
+        }
+    }
+
+    return (fclose(file) == 0) ? 0 : -1;
+}
+
+void SSD1327ZB_emulatorWriteCounters (const SSD1327ZB_Emulator* emu,
+                                      FILE* file,
+                                      const char* label,
+                                      uint32_t iterations,
+                                      uint64_t nanoseconds)
+{
+    const SSD1327ZB_EmulatorCounters* counters = &emu->counters;
+
+    if (iterations == 0) iterations = 1;
+
+    fprintf(file,
+            "{\"op\":\"%s\",\"iterations\":%" PRIu32 ","
+            "\"ns_per_op\":%" PRIu64 ","
+            "\"transactions_per_op\":%.2f,"
+            "\"command_bytes_per_op\":%.2f,"
+            "\"data_bytes_per_op\":%.2f,"
+            "\"redundant_bytes_per_op\":%.2f}\n",
+            label,
+            iterations,
+            nanoseconds / iterations,
+            (double) counters->transactions / iterations,
+            (double) counters->commandBytes / iterations,
+            (double) counters->dataBytes / iterations,
+            (double) counters->redundantBytes / iterations);
+}
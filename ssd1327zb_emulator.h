@@ -0,0 +1,178 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef __WARCOMEB_SSD1327ZB_EMULATOR_H
+#define __WARCOMEB_SSD1327ZB_EMULATOR_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Software model of the SSD1327 controller, used to run the driver on a host
+ * machine. To route the driver to the emulator define into board.h:
+ *     #define WARCOMEB_SSD1327ZB_EMULATOR
+ * and set the emulator field of the device before calling SSD1327ZB_init.
+ */
+
+#define SSD1327ZB_EMULATOR_ROWS                128
+#define SSD1327ZB_EMULATOR_COLUMNS             64 /**< Column pairs */
+
+/**
+ * Display mode selected with the A4h-A7h commands.
+ */
+typedef enum _SSD1327ZB_EmulatorMode
+{
+    SSD1327ZB_EMULATORMODE_NORMAL  = 0,
+    SSD1327ZB_EMULATORMODE_ALLON   = 1,
+    SSD1327ZB_EMULATORMODE_ALLOFF  = 2,
+    SSD1327ZB_EMULATORMODE_INVERSE = 3,
+} SSD1327ZB_EmulatorMode;
+
+/**
+ * Bus traffic seen by the emulator.
+ */
+typedef struct _SSD1327ZB_EmulatorCounters
+{
+    uint32_t transactions;                      /**< Number of bus transfers */
+    uint32_t commands;                      /**< Number of decoded commands */
+    uint32_t commandBytes;      /**< Command bytes, arguments included */
+    uint32_t dataBytes;                        /**< Number of data bytes */
+    uint32_t redundantBytes; /**< Data bytes equal to the GDDRAM content */
+    uint32_t unknownCommands;             /**< Commands not decoded */
+} SSD1327ZB_EmulatorCounters;
+
+typedef struct _SSD1327ZB_Emulator
+{
+    /** Display memory, every byte holds two pixels (low nibble first) */
+    uint8_t gddram [SSD1327ZB_EMULATOR_ROWS][SSD1327ZB_EMULATOR_COLUMNS];
+
+    uint8_t columnStart;
+    uint8_t columnStop;
+    uint8_t rowStart;
+    uint8_t rowStop;
+    uint8_t column;                         /**< Current column address */
+    uint8_t row;                                  /**< Current row address */
+
+    uint8_t remap;                      /**< Last value of the remap command */
+    uint8_t startLine;
+    uint8_t displayOffset;
+    uint8_t contrast;
+    uint8_t grayTable [15];          /**< Custom gray scale table GS1..GS15 */
+    uint8_t isOn;
+    uint8_t isScrolling;
+    SSD1327ZB_EmulatorMode mode;
+
+    /** Command being decoded and its arguments */
+    uint8_t command;
+    uint8_t arguments [15];
+    uint8_t argumentsCount;
+    uint8_t argumentsExpected;
+
+    SSD1327ZB_EmulatorCounters counters;
+
+} SSD1327ZB_Emulator;
+
+/**
+ * The function reset the emulator to the power-on state of the controller.
+ *
+ * @param[in] emu The handle of the emulator
+ */
+void SSD1327ZB_emulatorInit (SSD1327ZB_Emulator* emu);
+
+/**
+ * The function reset all the bus counters.
+ *
+ * @param[in] emu The handle of the emulator
+ */
+void SSD1327ZB_emulatorResetCounters (SSD1327ZB_Emulator* emu);
+
+/**
+ * The function must be called at the start of every bus transfer.
+ *
+ * @param[in] emu The handle of the emulator
+ */
+void SSD1327ZB_emulatorTransaction (SSD1327ZB_Emulator* emu);
+
+/**
+ * The function decode a command byte (or an argument of the current command).
+ *
+ * @param[in] emu The handle of the emulator
+ * @param[in] value The byte received with D/C low
+ */
+void SSD1327ZB_emulatorCommand (SSD1327ZB_Emulator* emu, uint8_t value);
+
+/**
+ * The function store a data byte into the GDDRAM at the current address
+ * and move the address inside the current window.
+ *
+ * @param[in] emu The handle of the emulator
+ * @param[in] value The byte received with D/C high
+ */
+void SSD1327ZB_emulatorData (SSD1327ZB_Emulator* emu, uint8_t value);
+
+/**
+ * The function return the gray level shown by the panel in the selected
+ * position, applying remap, start line, display offset and display mode.
+ *
+ * @param[in] emu The handle of the emulator
+ * @param[in] xPos The x position on the panel
+ * @param[in] yPos The y position on the panel
+ * @return The gray level, from 0 to 15.
+ */
+uint8_t SSD1327ZB_emulatorGetPixel (const SSD1327ZB_Emulator* emu,
+                                    uint8_t xPos,
+                                    uint8_t yPos);
+
+/**
+ * The function save the image shown by the panel as a binary PGM file.
+ *
+ * @param[in] emu The handle of the emulator
+ * @param[in] filename The name of the file to be written
+ * @return 0 on success, -1 otherwise.
+ */
+int SSD1327ZB_emulatorSavePgm (const SSD1327ZB_Emulator* emu,
+                               const char* filename);
+
+/**
+ * The function write the bus counters as a single JSON line, so the results
+ * of different runs or releases can be compared by a script.
+ * The optional time is the measured duration of the operation.
+ *
+ * @param[in] emu The handle of the emulator
+ * @param[in] file The output stream
+ * @param[in] label The name of the measured operation
+ * @param[in] iterations The number of times the operation has been repeated
+ * @param[in] nanoseconds The total time spent by the operation, 0 if unknown
+ */
+void SSD1327ZB_emulatorWriteCounters (const SSD1327ZB_Emulator* emu,
+                                      FILE* file,
+                                      const char* label,
+                                      uint32_t iterations,
+                                      uint64_t nanoseconds);
+
+#endif /* __WARCOMEB_SSD1327ZB_EMULATOR_H */
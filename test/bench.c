@@ -0,0 +1,216 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+
+/*
+ * Host benchmark of the flush and drawing paths. Every workload is repeated
+ * on the emulator and written as a JSON line with the time and the bus
+ * traffic of one operation, so two releases can be compared by a script:
+ *     make -C test bench > results.jsonl
+ * The drawing workloads are measured twice: the drawing alone, that sends
+ * nothing on the bus, and the drawing followed by SSD1327ZB_flushDirty.
+ */
+
+#include <time.h>
+
+#include "test.h"
+#include "rle_pictures.h"
+
+static SSD1327ZB_Device dev;
+
+/** Pseudo random geometry, the same sequence at every run */
+static uint32_t Bench_seed = 0x12345678u;
+
+static uint8_t Bench_random (uint8_t limit)
+{
+    Bench_seed ^= Bench_seed << 13;
+    Bench_seed ^= Bench_seed >> 17;
+    Bench_seed ^= Bench_seed << 5;
+    return (uint8_t)(Bench_seed % limit);
+}
+
+static uint8_t Bench_picture1 [32*32/8];
+static uint8_t Bench_picture4 [32*32/2];
+
+typedef void (*Bench_Operation) (uint32_t i);
+
+static uint64_t Bench_now (void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC,&now);
+    return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * The function repeat an operation and write its counters. When flush is
+ * true the dirty areas are sent after every operation.
+ */
+static void Bench_run (const char* label,
+                       Bench_Operation operation,
+                       uint32_t iterations,
+                       bool flush)
+{
+    char name[64];
+
+    // Start every workload from the same clean state
+    SSD1327ZB_clear(&dev);
+    SSD1327ZB_flush(&dev);
+    Bench_seed = 0x12345678u;
+    SSD1327ZB_emulatorResetCounters(&MockBus_panel);
+
+    uint64_t start = Bench_now();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        operation(i);
+        if (flush) SSD1327ZB_flushDirty(&dev);
+    }
+    uint64_t stop = Bench_now();
+
+    snprintf(name,sizeof(name),"%s%s",label,(flush) ? "+flushDirty" : "");
+    SSD1327ZB_emulatorWriteCounters(&MockBus_panel,stdout,name,iterations,stop - start);
+}
+
+static void Bench_flush (uint32_t i)
+{
+    SSD1327ZB_flush(&dev);
+}
+
+static void Bench_flushPart (uint32_t i)
+{
+    // A 24x12 widget, like a value on a dashboard
+    uint8_t x = Bench_random(128 - 24);
+    uint8_t y = Bench_random(128 - 12);
+    SSD1327ZB_flushPart(&dev,x,x + 23,y,y + 11);
+}
+
+static void Bench_drawLine (uint32_t i)
+{
+    SSD1327ZB_drawLine(&dev,Bench_random(128),Bench_random(128),
+                       Bench_random(128),Bench_random(128),(i % 15) + 1);
+}
+
+static void Bench_drawHLine (uint32_t i)
+{
+    SSD1327ZB_drawHLine(&dev,Bench_random(128),Bench_random(128),
+                        Bench_random(128),(i % 15) + 1);
+}
+
+static void Bench_drawVLine (uint32_t i)
+{
+    SSD1327ZB_drawVLine(&dev,Bench_random(128),Bench_random(128),
+                        Bench_random(128),(i % 15) + 1);
+}
+
+static void Bench_drawRectangle (uint32_t i)
+{
+    SSD1327ZB_drawRectangle(&dev,Bench_random(128 - 30),Bench_random(128 - 20),
+                            30,20,(i % 15) + 1,TRUE);
+}
+
+static void Bench_drawChar (uint32_t i)
+{
+    // A full screen of text: 21 columns and 16 rows of 6x8 characters
+    for (uint8_t row = 0; row < 16; ++row)
+    {
+        for (uint8_t column = 0; column < 21; ++column)
+        {
+            SSD1327ZB_drawChar(&dev,column * 6,row * 8,
+                               ' ' + ((i + row + column) % 95),
+                               SSD1327ZB_GRAYSCALE_15,
+                               SSD1327ZB_GRAYSCALE_0,1);
+        }
+    }
+}
+
+static void Bench_drawPicture1 (uint32_t i)
+{
+    SSD1327ZB_drawPicture(&dev,Bench_random(128 - 32),Bench_random(128 - 32),
+                          32,32,Bench_picture1,GDL_PICTURETYPE_1BIT);
+}
+
+static void Bench_drawPicture4 (uint32_t i)
+{
+    SSD1327ZB_drawPicture(&dev,Bench_random(128 - 32),Bench_random(128 - 32),
+                          32,32,Bench_picture4,GDL_PICTURETYPE_4BIT);
+}
+
+static void Bench_drawCompressed (uint32_t i)
+{
+    SSD1327ZB_drawCompressedPicture(&dev,0,Bench_random(128 - RLE_SPLASH_HEIGHT),
+                                    RLE_SPLASH_WIDTH,RLE_SPLASH_HEIGHT,rle_splash);
+}
+
+static void Bench_sendCompressed (uint32_t i)
+{
+    SSD1327ZB_sendCompressedPicture(&dev,0,Bench_random(128 - RLE_SPLASH_HEIGHT),
+                                    RLE_SPLASH_WIDTH,RLE_SPLASH_HEIGHT,rle_splash);
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+
+    for (uint16_t i = 0; i < sizeof(Bench_picture1); ++i)
+    {
+        Bench_picture1[i] = (uint8_t)(i * 37);
+    }
+    for (uint16_t i = 0; i < sizeof(Bench_picture4); ++i)
+    {
+        Bench_picture4[i] = (uint8_t)(i * 13);
+    }
+
+    Bench_run("flush",Bench_flush,500,FALSE);
+    Bench_run("flushPart",Bench_flushPart,20000,FALSE);
+    Bench_run("sendCompressed",Bench_sendCompressed,2000,FALSE);
+
+    static const struct
+    {
+        const char* label;
+        Bench_Operation operation;
+        uint32_t iterations;
+    } draws[] =
+    {
+        {"drawLine",      Bench_drawLine,      20000},
+        {"drawHLine",     Bench_drawHLine,     20000},
+        {"drawVLine",     Bench_drawVLine,     20000},
+        {"drawRectangle", Bench_drawRectangle, 20000},
+        {"drawChar",      Bench_drawChar,      200},
+        {"drawPicture1",  Bench_drawPicture1,  20000},
+        {"drawPicture4",  Bench_drawPicture4,  20000},
+        {"drawCompressed",Bench_drawCompressed,2000},
+    };
+
+    for (uint8_t i = 0; i < sizeof(draws)/sizeof(draws[0]); ++i)
+    {
+        Bench_run(draws[i].label,draws[i].operation,draws[i].iterations,FALSE);
+        Bench_run(draws[i].label,draws[i].operation,draws[i].iterations,TRUE);
+    }
+    return 0;
+}
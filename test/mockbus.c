@@ -0,0 +1,314 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+#include "mockbus.h"
+
+#define MOCKBUS_I2C_ADDRESS                    0x3C
+
+typedef enum _MockBus_I2cState
+{
+    MOCKBUS_I2CSTATE_IDLE,
+    MOCKBUS_I2CSTATE_ADDRESS,
+    MOCKBUS_I2CSTATE_CONTROL,
+    MOCKBUS_I2CSTATE_SINGLE,          /**< One byte, then a control byte */
+    MOCKBUS_I2CSTATE_STREAM,       /**< All the bytes until the stop */
+} MockBus_I2cState;
+
+SSD1327ZB_Emulator MockBus_panel;
+SSD1327ZB_Emulator MockBus_otherPanel;
+MockBus_Counters MockBus_counters;
+uint8_t MockBus_commandLog [MOCKBUS_COMMAND_LOG];
+
+volatile uint32_t MockBus_portSet;
+volatile uint32_t MockBus_portClear;
+volatile uint32_t MockBus_otherSet;
+volatile uint32_t MockBus_otherClear;
+
+uint8_t MockBus_portShift;
+uint8_t MockBus_otherLine = MOCKBUS_LINE_NONE;
+uint8_t MockBus_unknownLine = MOCKBUS_LINE_NONE;
+
+static uint8_t MockBus_pins [GPIO_PINS_COUNT];
+/** Level of the data lines, d0 is the bit 0 */
+static uint8_t MockBus_dataLines;
+
+static MockBus_I2cState MockBus_i2cState;
+static bool MockBus_i2cIsData;
+
+void MockBus_init (void)
+{
+    SSD1327ZB_emulatorInit(&MockBus_panel);
+    SSD1327ZB_emulatorInit(&MockBus_otherPanel);
+    memset(MockBus_pins,1,sizeof(MockBus_pins));
+    MockBus_dataLines = 0;
+    MockBus_portSet = 0;
+    MockBus_portClear = 0;
+    MockBus_otherSet = 0;
+    MockBus_otherClear = 0;
+    MockBus_i2cState = MOCKBUS_I2CSTATE_IDLE;
+    MockBus_resetCounters();
+}
+
+void MockBus_resetCounters (void)
+{
+    memset(&MockBus_counters,0,sizeof(MockBus_counters));
+    memset(MockBus_commandLog,0,sizeof(MockBus_commandLog));
+    SSD1327ZB_emulatorResetCounters(&MockBus_panel);
+    SSD1327ZB_emulatorResetCounters(&MockBus_otherPanel);
+}
+
+void MockBus_delay (uint32_t ms)
+{
+    (void) ms;
+}
+
+uint8_t MockBus_getPixel (uint8_t xPos, uint8_t yPos)
+{
+    uint8_t value = MockBus_panel.gddram[yPos][xPos/2];
+    return (xPos%2) ? (value >> 4) : (value & 0x0F);
+}
+
+bool MockBus_portMapper (Gpio_Pins pin,
+                         volatile uint32_t** setRegister,
+                         volatile uint32_t** clearRegister,
+                         uint8_t* bit)
+{
+    if ((pin < GPIO_PINS_PTA0) || (pin > GPIO_PINS_PTA7))
+        return FALSE;
+
+    uint8_t line = pin - GPIO_PINS_PTA0;
+    if (line == MockBus_unknownLine)
+        return FALSE;
+
+    if (line == MockBus_otherLine)
+    {
+        *setRegister = &MockBus_otherSet;
+        *clearRegister = &MockBus_otherClear;
+    }
+    else
+    {
+        *setRegister = &MockBus_portSet;
+        *clearRegister = &MockBus_portClear;
+    }
+    *bit = MockBus_portShift + line;
+    return TRUE;
+}
+
+/**
+ * @return The panel selected by the chip selects of the parallel and SPI
+ *         bus, 0 when no panel or both are selected.
+ */
+static SSD1327ZB_Emulator* MockBus_getSelected (void)
+{
+    bool isPanel = (MockBus_pins[MOCKBUS_PIN_CS] == 0) ? TRUE : FALSE;
+    bool isOther = (MockBus_pins[MOCKBUS_PIN_CS_OTHER] == 0) ? TRUE : FALSE;
+
+    if (isPanel == isOther)
+        return 0;
+    return (isPanel) ? &MockBus_panel : &MockBus_otherPanel;
+}
+
+/**
+ * The function send a decoded byte to a panel.
+ */
+static void MockBus_deliver (SSD1327ZB_Emulator* panel, bool isData, uint8_t value)
+{
+    if (isData)
+    {
+        MockBus_counters.dataBytes++;
+        SSD1327ZB_emulatorData(panel,value);
+    }
+    else
+    {
+        if (MockBus_counters.commandBytes < MOCKBUS_COMMAND_LOG)
+            MockBus_commandLog[MockBus_counters.commandBytes] = value;
+        MockBus_counters.commandBytes++;
+        SSD1327ZB_emulatorCommand(panel,value);
+    }
+}
+
+/**
+ * The function apply the writes of the fake port registers to the data
+ * lines, as the hardware does when the registers are written.
+ */
+static void MockBus_applyPort (void)
+{
+    if ((MockBus_portSet | MockBus_portClear) != 0)
+        MockBus_counters.portWrites++;
+
+    for (uint8_t line = 0; line < 8; ++line)
+    {
+        uint32_t mask = (uint32_t) 1 << (MockBus_portShift + line);
+        if (MockBus_portSet & mask)
+            MockBus_dataLines |= (1 << line);
+        if (MockBus_portClear & mask)
+            MockBus_dataLines &= ~(1 << line);
+    }
+    MockBus_portSet = 0;
+    MockBus_portClear = 0;
+}
+
+static void MockBus_setPin (Gpio_Pins pin, uint8_t level)
+{
+    MockBus_counters.gpioCalls++;
+
+    if ((pin >= GPIO_PINS_PTA0) && (pin <= GPIO_PINS_PTA7))
+    {
+        uint8_t mask = 1 << (pin - GPIO_PINS_PTA0);
+        MockBus_dataLines = (level) ? (MockBus_dataLines | mask) : (MockBus_dataLines & ~mask);
+        return;
+    }
+
+    uint8_t previous = MockBus_pins[pin];
+    MockBus_pins[pin] = level;
+    if (previous == level) return;
+
+    switch (pin)
+    {
+    case MOCKBUS_PIN_CS:
+    case MOCKBUS_PIN_CS_OTHER:
+        MockBus_counters.csToggles++;
+        if (level == 0)
+        {
+            MockBus_counters.transactions++;
+            SSD1327ZB_emulatorTransaction((pin == MOCKBUS_PIN_CS) ? &MockBus_panel : &MockBus_otherPanel);
+        }
+        break;
+
+    case MOCKBUS_PIN_WR:
+        // The parallel bus latch the data on the rising edge
+        if (level == 0) break;
+        MockBus_applyPort();
+        if (MockBus_getSelected() == 0)
+            MockBus_counters.errors++;
+        else
+            MockBus_deliver(MockBus_getSelected(),MockBus_pins[MOCKBUS_PIN_DC],MockBus_dataLines);
+        break;
+
+    case MOCKBUS_PIN_RST:
+        if (level == 0)
+            SSD1327ZB_emulatorInit(&MockBus_panel);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void Gpio_set (Gpio_Pins pin)
+{
+    MockBus_setPin(pin,1);
+}
+
+void Gpio_clear (Gpio_Pins pin)
+{
+    MockBus_setPin(pin,0);
+}
+
+void Gpio_toggle (Gpio_Pins pin)
+{
+    MockBus_setPin(pin,!MockBus_pins[pin]);
+}
+
+System_Errors Gpio_config (Gpio_Pins pin, uint16_t options)
+{
+    (void) pin;
+    (void) options;
+    return ERRORS_NO_ERROR;
+}
+
+System_Errors Spi_writeByte (Spi_DeviceHandle dev, uint8_t data)
+{
+    (void) dev;
+
+    if (MockBus_getSelected() == 0)
+        MockBus_counters.errors++;
+    else
+        MockBus_deliver(MockBus_getSelected(),MockBus_pins[MOCKBUS_PIN_DC],data);
+    return ERRORS_NO_ERROR;
+}
+
+System_Errors Iic_start (Iic_DeviceHandle dev)
+{
+    (void) dev;
+
+    MockBus_counters.transactions++;
+    SSD1327ZB_emulatorTransaction(&MockBus_panel);
+    MockBus_i2cState = MOCKBUS_I2CSTATE_ADDRESS;
+    return ERRORS_NO_ERROR;
+}
+
+System_Errors Iic_stop (Iic_DeviceHandle dev)
+{
+    (void) dev;
+
+    // A command without its arguments is an error of the framing
+    if (MockBus_i2cState == MOCKBUS_I2CSTATE_SINGLE)
+        MockBus_counters.errors++;
+    MockBus_i2cState = MOCKBUS_I2CSTATE_IDLE;
+    return ERRORS_NO_ERROR;
+}
+
+System_Errors Iic_writeByte (Iic_DeviceHandle dev, uint8_t data)
+{
+    (void) dev;
+
+    switch (MockBus_i2cState)
+    {
+    case MOCKBUS_I2CSTATE_IDLE:
+        MockBus_counters.errors++;
+        break;
+
+    case MOCKBUS_I2CSTATE_ADDRESS:
+        MockBus_counters.framingBytes++;
+        if (data != (MOCKBUS_I2C_ADDRESS << 1))
+            MockBus_counters.errors++;
+        MockBus_i2cState = MOCKBUS_I2CSTATE_CONTROL;
+        break;
+
+    case MOCKBUS_I2CSTATE_CONTROL:
+        MockBus_counters.framingBytes++;
+        if ((data & 0x3F) != 0)
+            MockBus_counters.errors++;
+        // Continuation bit: only the next byte, then another control byte
+        MockBus_i2cIsData = (data & 0x40) ? TRUE : FALSE;
+        MockBus_i2cState = (data & 0x80) ? MOCKBUS_I2CSTATE_SINGLE : MOCKBUS_I2CSTATE_STREAM;
+        break;
+
+    case MOCKBUS_I2CSTATE_SINGLE:
+        MockBus_deliver(&MockBus_panel,MockBus_i2cIsData,data);
+        MockBus_i2cState = MOCKBUS_I2CSTATE_CONTROL;
+        break;
+
+    case MOCKBUS_I2CSTATE_STREAM:
+        MockBus_deliver(&MockBus_panel,MockBus_i2cIsData,data);
+        break;
+    }
+    return ERRORS_NO_ERROR;
+}
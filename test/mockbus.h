@@ -0,0 +1,126 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+#ifndef __WARCOMEB_SSD1327ZB_MOCKBUS_H
+#define __WARCOMEB_SSD1327ZB_MOCKBUS_H
+
+/*
+ * Recording mock of the libohiboard GPIO, SPI and I2C functions. The bytes
+ * seen on the bus are decoded as the controller does (write strobe and D/C
+ * line for the parallel bus, D/C line for SPI, control bytes for I2C) and
+ * sent to an emulated panel, so a test can check both the traffic and the
+ * final image with any transport.
+ */
+
+#include "libohiboard.h"
+#include "ssd1327zb_emulator.h"
+
+/*
+ * Pins used by the tests: the data lines are GPIO_PINS_PTA0..GPIO_PINS_PTA7.
+ */
+#define MOCKBUS_PIN_RD                         GPIO_PINS_PTB0
+#define MOCKBUS_PIN_DC                         GPIO_PINS_PTB1
+#define MOCKBUS_PIN_RS                         GPIO_PINS_PTB2
+#define MOCKBUS_PIN_CS                         GPIO_PINS_PTB3
+#define MOCKBUS_PIN_WR                         GPIO_PINS_PTB4
+#define MOCKBUS_PIN_RST                        GPIO_PINS_PTB5
+/** Chip select of the second panel, on the same parallel or SPI bus */
+#define MOCKBUS_PIN_CS_OTHER                   GPIO_PINS_PTB6
+
+/** Value written by the tests when no data line must be moved or fail */
+#define MOCKBUS_LINE_NONE                      8
+
+typedef struct _MockBus_Counters
+{
+    uint32_t transactions;      /**< Chip select asserted or I2C start */
+    uint32_t csToggles;                /**< Edges of the chip select line */
+    uint32_t commandBytes;                    /**< Bytes decoded as command */
+    uint32_t dataBytes;                          /**< Bytes decoded as data */
+    uint32_t framingBytes;             /**< I2C address and control bytes */
+    uint32_t gpioCalls;                  /**< Calls of Gpio_set/Gpio_clear */
+    uint32_t portWrites;           /**< Bytes written by the fake port */
+    uint32_t errors;     /**< Bytes out of a transaction or badly framed */
+} MockBus_Counters;
+
+/** Number of command bytes kept by the log of the bus */
+#define MOCKBUS_COMMAND_LOG                    64
+
+/** The panel connected to the bus */
+extern SSD1327ZB_Emulator MockBus_panel;
+/** The second panel, selected by MOCKBUS_PIN_CS_OTHER */
+extern SSD1327ZB_Emulator MockBus_otherPanel;
+extern MockBus_Counters MockBus_counters;
+
+/** The first command bytes seen since the last reset of the counters */
+extern uint8_t MockBus_commandLog [MOCKBUS_COMMAND_LOG];
+
+/** Fake set and clear registers of the port of the data lines */
+extern volatile uint32_t MockBus_portSet;
+extern volatile uint32_t MockBus_portClear;
+/** Fake registers of a second port */
+extern volatile uint32_t MockBus_otherSet;
+extern volatile uint32_t MockBus_otherClear;
+
+/** Bit of the port used by d0, the other lines follow */
+extern uint8_t MockBus_portShift;
+/** Data line mapped on the second port */
+extern uint8_t MockBus_otherLine;
+/** Data line the mapper can't describe */
+extern uint8_t MockBus_unknownLine;
+
+/**
+ * The function reset the panels, the pins and the counters.
+ */
+void MockBus_init (void);
+
+/**
+ * The function reset only the counters and the log of the commands.
+ */
+void MockBus_resetCounters (void);
+
+/**
+ * Port mapper for the fast parallel path: the data lines are on the fake
+ * port, starting from MockBus_portShift.
+ */
+bool MockBus_portMapper (Gpio_Pins pin,
+                         volatile uint32_t** setRegister,
+                         volatile uint32_t** clearRegister,
+                         uint8_t* bit);
+
+/**
+ * Delay callback of the devices: nothing to wait on the host.
+ */
+void MockBus_delay (uint32_t ms);
+
+/**
+ * The function return the gray level of a pixel of the panel memory.
+ */
+uint8_t MockBus_getPixel (uint8_t xPos, uint8_t yPos);
+
+#endif /* __WARCOMEB_SSD1327ZB_MOCKBUS_H */
@@ -0,0 +1,124 @@
+/* Generated by ssd1327zb_rle.py */
+
+#include <stdint.h>
+
+#define RLE_CARD_WIDTH 37
+#define RLE_CARD_HEIGHT 23
+const uint8_t rle_card[259] =
+{
+    0x57, 0x0C, 0x80, 0x31, 0x37, 0x06, 0x94, 0x29, 0x37, 0xAE, 0xC9, 0x4F,
+    0x6A, 0x4D, 0x21, 0xF6, 0x94, 0x7F, 0x94, 0xAE, 0x90, 0x22, 0x08, 0x49,
+    0xA9, 0x8B, 0xEA, 0x5B, 0x37, 0x0A, 0x8B, 0xF8, 0x67, 0x72, 0xA4, 0xED,
+    0xBB, 0xAB, 0xAF, 0x45, 0x8A, 0xDB, 0x49, 0x23, 0x77, 0x0A, 0x82, 0x53,
+    0x39, 0xCD, 0x67, 0x03, 0x88, 0x72, 0x46, 0x75, 0xA8, 0xD4, 0xF4, 0xC7,
+    0xA8, 0x42, 0x2F, 0x06, 0x6F, 0x0C, 0x67, 0x01, 0x83, 0xD5, 0xFA, 0x2F,
+    0x02, 0x47, 0x0A, 0x35, 0x3B, 0x7F, 0x04, 0x83, 0xC0, 0xCE, 0x6C, 0xBD,
+    0x0F, 0x07, 0x83, 0xE2, 0xB0, 0xAC, 0x69, 0x0B, 0x80, 0xB3, 0x5C, 0x7F,
+    0x06, 0x17, 0x06, 0x85, 0xDC, 0x4D, 0x26, 0xCA, 0xD0, 0x08, 0x77, 0x09,
+    0x5E, 0x89, 0x15, 0x69, 0x10, 0xB7, 0x6B, 0x14, 0x3E, 0x16, 0x11, 0x71,
+    0x3F, 0x03, 0x87, 0x1F, 0xC8, 0xBA, 0x6B, 0x89, 0x64, 0x95, 0x20, 0x2F,
+    0x03, 0x5B, 0x81, 0xA2, 0xA0, 0x77, 0x0A, 0x33, 0x3F, 0x06, 0x8B, 0x33,
+    0x20, 0x5F, 0xC6, 0x45, 0xC4, 0x87, 0xE5, 0xBE, 0x8F, 0xB3, 0x19, 0x0F,
+    0x01, 0x05, 0x2F, 0x09, 0x85, 0x36, 0x92, 0x43, 0xFC, 0x82, 0x28, 0x17,
+    0x08, 0x84, 0x54, 0x84, 0x43, 0x8C, 0x8B, 0x6C, 0x16, 0x27, 0x0C, 0x80,
+    0x83, 0x46, 0x67, 0x0B, 0x82, 0x98, 0x33, 0xB3, 0x5F, 0x09, 0x81, 0x00,
+    0x61, 0x47, 0x05, 0x89, 0x24, 0x7F, 0xC1, 0x04, 0xCA, 0x1F, 0xA4, 0x05,
+    0x3F, 0xB4, 0x5F, 0x04, 0x8A, 0xCA, 0x2F, 0x56, 0x80, 0x98, 0xCA, 0x91,
+    0xC9, 0x3A, 0xBD, 0x24, 0x17, 0x0A, 0x82, 0x74, 0x0F, 0x6B, 0x77, 0x0C,
+    0x1F, 0x02, 0x82, 0x2E, 0x93, 0xC4, 0x57, 0x00, 0x3C, 0x84, 0x08, 0xEA,
+    0xBD, 0x4B, 0x78, 0x07, 0x01, 0x86, 0xB5, 0x83, 0x6D, 0x09, 0xA4, 0xB4,
+    0x63, 0x5E, 0x81, 0x00, 0xA0, 0x57, 0x02,
+};
+
+#define RLE_SPLASH_WIDTH 128
+#define RLE_SPLASH_HEIGHT 40
+const uint8_t rle_splash[1039] =
+{
+    0x07, 0xFF, 0x07, 0xFF, 0x07, 0xFF, 0x07, 0xFF, 0x07, 0xE4, 0x0F, 0x00,
+    0x17, 0x00, 0x1F, 0x00, 0x27, 0x00, 0x2F, 0x00, 0x37, 0x00, 0x3F, 0x00,
+    0x47, 0x00, 0x4F, 0x00, 0x57, 0x00, 0x5F, 0x00, 0x67, 0x00, 0x6F, 0x00,
+    0x77, 0x00, 0x7F, 0x00, 0x07, 0x00, 0x0F, 0x00, 0x17, 0x00, 0x1F, 0x00,
+    0x27, 0x00, 0x2F, 0x00, 0x37, 0x00, 0x3F, 0x00, 0x47, 0x00, 0x4F, 0x00,
+    0x57, 0x00, 0x5F, 0x00, 0x67, 0x00, 0x6F, 0x00, 0x77, 0x00, 0x7F, 0x00,
+    0x07, 0x00, 0x0F, 0x00, 0x17, 0x00, 0x1F, 0x00, 0x27, 0x00, 0x2F, 0x00,
+    0x37, 0x00, 0x3F, 0x00, 0x47, 0x00, 0x4F, 0x00, 0x57, 0x00, 0x5F, 0x00,
+    0x67, 0x00, 0x6F, 0x00, 0x77, 0x00, 0x7F, 0x00, 0x07, 0x00, 0x0F, 0x00,
+    0x17, 0x00, 0x1F, 0x00, 0x27, 0x00, 0x2F, 0x00, 0x37, 0x00, 0x3F, 0x00,
+    0x47, 0x00, 0x4F, 0x00, 0x57, 0x00, 0x5F, 0x00, 0x67, 0x00, 0x6F, 0x00,
+    0x77, 0x00, 0x7F, 0x00, 0x07, 0x00, 0x0F, 0x00, 0x17, 0x00, 0x1F, 0x00,
+    0x27, 0x00, 0x2F, 0x00, 0x37, 0x00, 0x3F, 0x00, 0x47, 0x00, 0x4F, 0x00,
+    0x57, 0x00, 0x5F, 0x00, 0x67, 0x00, 0x6F, 0x00, 0x77, 0x00, 0x7F, 0x00,
+    0x07, 0x00, 0x0F, 0x00, 0x17, 0x00, 0x1F, 0x00, 0x27, 0x00, 0x2F, 0x00,
+    0x37, 0x00, 0x3F, 0x00, 0x47, 0x00, 0x4F, 0x00, 0x57, 0x00, 0x5F, 0x00,
+    0x67, 0x00, 0x6F, 0x00, 0x77, 0x00, 0x7F, 0x00, 0x07, 0x00, 0x0F, 0x00,
+    0x17, 0x00, 0x1F, 0x00, 0x27, 0x00, 0x2F, 0x00, 0x37, 0x00, 0x3F, 0x00,
+    0x47, 0x00, 0x4F, 0x00, 0x57, 0x00, 0x5F, 0x00, 0x67, 0x00, 0x6F, 0x00,
+    0x77, 0x00, 0x7F, 0x00, 0x07, 0x00, 0x0F, 0x00, 0x17, 0x00, 0x1F, 0x00,
+    0x27, 0x00, 0x2F, 0x00, 0x37, 0x00, 0x3F, 0x00, 0x47, 0x00, 0x4F, 0x00,
+    0x57, 0x00, 0x5F, 0x00, 0x67, 0x00, 0x6F, 0x00, 0x77, 0x00, 0x7F, 0x00,
+    0x07, 0x00, 0x0F, 0x00, 0x17, 0x00, 0x1F, 0x00, 0x27, 0x00, 0x2F, 0x00,
+    0x37, 0x00, 0x3F, 0x00, 0x47, 0x00, 0x4F, 0x00, 0x57, 0x00, 0x5F, 0x00,
+    0x67, 0x00, 0x6F, 0x00, 0x77, 0x00, 0x7F, 0x00, 0x07, 0x00, 0x0F, 0x00,
+    0x17, 0x00, 0x1F, 0x00, 0x27, 0x00, 0x2F, 0x00, 0x37, 0x00, 0x3F, 0x00,
+    0x47, 0x00, 0x4F, 0x00, 0x57, 0x00, 0x5F, 0x00, 0x67, 0x00, 0x6F, 0x00,
+    0x77, 0x00, 0x7F, 0x00, 0xFF, 0x7C, 0x27, 0x1F, 0x23, 0x6A, 0x37, 0xD6,
+    0x81, 0xAA, 0x92, 0x07, 0x4A, 0x9D, 0x3E, 0x34, 0xEF, 0xEF, 0xCD, 0xC9,
+    0xBB, 0x98, 0xC3, 0xDA, 0x6B, 0xF1, 0x82, 0xE6, 0x73, 0xFA, 0xE2, 0x8B,
+    0x6B, 0x28, 0x8A, 0x78, 0x06, 0xEE, 0xC1, 0x08, 0x0F, 0x77, 0x1A, 0xB5,
+    0x88, 0x5F, 0xB9, 0x0E, 0xE9, 0xB8, 0xBF, 0x0C, 0xFB, 0x51, 0x7B, 0x35,
+    0x46, 0x18, 0x0F, 0x53, 0x4D, 0xB4, 0x70, 0x24, 0xFC, 0x37, 0xA1, 0xF0,
+    0x4A, 0xB3, 0x77, 0xB6, 0xCA, 0x3A, 0x00, 0xC6, 0x3D, 0x55, 0x43, 0x48,
+    0x2E, 0x5A, 0x50, 0x0F, 0x0A, 0x6E, 0x6C, 0x8C, 0x5E, 0x77, 0xB2, 0x26,
+    0x37, 0x9B, 0x99, 0x02, 0x95, 0x40, 0xC5, 0x0D, 0x7C, 0xDB, 0x51, 0xEB,
+    0xBD, 0x1D, 0x3B, 0x4E, 0x0B, 0xB3, 0xDC, 0xDC, 0xA0, 0xAB, 0x12, 0xB7,
+    0x5D, 0x45, 0xAA, 0xA8, 0xB5, 0x1C, 0x6D, 0xF6, 0x77, 0x18, 0xC2, 0x4B,
+    0x2C, 0xFF, 0xA8, 0x6B, 0xA0, 0x79, 0x62, 0xBF, 0x1D, 0x88, 0x80, 0xEA,
+    0xA4, 0x18, 0xAD, 0x34, 0xE4, 0xA4, 0x7D, 0xE2, 0x65, 0x3D, 0x91, 0x5E,
+    0xA4, 0x38, 0xDB, 0x9A, 0x15, 0xD4, 0x36, 0xFB, 0x76, 0xBB, 0xDA, 0xD4,
+    0x82, 0xCE, 0xDB, 0x99, 0xAE, 0x3F, 0x27, 0x8B, 0x3B, 0xC8, 0x73, 0x37,
+    0x31, 0x87, 0x82, 0x4D, 0x1E, 0x0C, 0xCA, 0x31, 0x1E, 0x9F, 0x7E, 0x35,
+    0x8D, 0xC1, 0xC8, 0x09, 0x4B, 0xBA, 0xB9, 0x16, 0x5E, 0x0F, 0xB5, 0x9E,
+    0x8E, 0xE9, 0x25, 0xAF, 0x27, 0x79, 0xF4, 0x85, 0xE4, 0xB7, 0xC1, 0xA4,
+    0x28, 0x22, 0x33, 0xB6, 0x78, 0xCA, 0x5F, 0x6E, 0x3E, 0x57, 0xF1, 0xED,
+    0xDD, 0xE0, 0x6B, 0xB9, 0x64, 0x51, 0xA0, 0xFC, 0xA8, 0xDA, 0x44, 0xF6,
+    0x26, 0xFB, 0xBC, 0xAA, 0xCB, 0xC8, 0xA2, 0x16, 0xC4, 0x76, 0x20, 0x05,
+    0x9C, 0x30, 0x7C, 0x68, 0x03, 0xAE, 0x77, 0xEF, 0x13, 0xD4, 0xFF, 0x80,
+    0x7E, 0xB3, 0x50, 0xCA, 0x4C, 0x3F, 0xB9, 0x91, 0x3E, 0xE2, 0x60, 0xE9,
+    0x68, 0xFD, 0xB8, 0xED, 0x3C, 0x8E, 0xA8, 0x16, 0xCC, 0x38, 0x86, 0xAA,
+    0xAB, 0x48, 0xA7, 0x47, 0x1C, 0x5B, 0xDC, 0xF5, 0x95, 0x06, 0xEA, 0x9E,
+    0xAF, 0x87, 0xFF, 0x56, 0xEA, 0xAF, 0x6E, 0x88, 0x41, 0x2F, 0x26, 0xA0,
+    0x0D, 0x05, 0x1E, 0x02, 0xE0, 0x84, 0xCE, 0xBF, 0x71, 0xC4, 0xFF, 0xDA,
+    0x70, 0x49, 0x8E, 0x61, 0x6A, 0xB9, 0xF7, 0x89, 0xCC, 0x86, 0x99, 0xA5,
+    0x10, 0x8E, 0x03, 0x94, 0x3E, 0x9C, 0xFE, 0x56, 0x89, 0x8B, 0x3F, 0xAB,
+    0x31, 0xD5, 0x26, 0x77, 0xD1, 0xED, 0xFB, 0xBD, 0x52, 0xBF, 0x41, 0xAF,
+    0xD7, 0x0E, 0x84, 0x0F, 0x93, 0xE0, 0x5A, 0x18, 0x41, 0x2C, 0x72, 0xD4,
+    0xE7, 0x78, 0xF7, 0xD4, 0x50, 0x6C, 0xC8, 0x9C, 0xD9, 0x80, 0x8D, 0x58,
+    0xF8, 0x47, 0x13, 0xD4, 0x1C, 0x92, 0x04, 0xFF, 0xAC, 0xEF, 0x7A, 0x63,
+    0x84, 0xB0, 0xFB, 0xD2, 0x24, 0x43, 0x13, 0x71, 0x99, 0x51, 0xC0, 0x9D,
+    0xD8, 0x00, 0x0A, 0xFE, 0x12, 0x5A, 0x0B, 0x61, 0x50, 0x13, 0x50, 0xE5,
+    0x99, 0x7A, 0x55, 0xC3, 0xD4, 0x5B, 0x33, 0xED, 0x3F, 0x10, 0x05, 0xE2,
+    0xEA, 0xFE, 0xC9, 0x42, 0x71, 0xE5, 0xFA, 0xB5, 0x84, 0xD9, 0x73, 0x02,
+    0x50, 0x77, 0x41, 0x73, 0xB5, 0x1F, 0x9C, 0xF8, 0x17, 0x23, 0xE5, 0x3F,
+    0x0C, 0xC6, 0x0B, 0x8A, 0x82, 0x53, 0x93, 0xD2, 0x2E, 0x47, 0x49, 0xE7,
+    0x04, 0x1C, 0x2E, 0x2E, 0xB0, 0x45, 0x93, 0x68, 0x71, 0x5F, 0x1B, 0x4C,
+    0xEC, 0xA8, 0x99, 0xFA, 0xB0, 0x15, 0xE2, 0xF0, 0xE8, 0x36, 0xE7, 0xF1,
+    0x52, 0xCA, 0x78, 0xA1, 0x25, 0x3D, 0x95, 0xE5, 0x6B, 0x4D, 0x8C, 0x7D,
+    0xA8, 0x4E, 0xB8, 0x30, 0x92, 0x8F, 0xEC, 0xFD, 0x48, 0x94, 0xC2, 0xB3,
+    0x91, 0x04, 0x41, 0xB4, 0xFF, 0xF4, 0x29, 0xFB, 0xBB, 0xBA, 0xB4, 0xC4,
+    0xEE, 0xF6, 0x55, 0x6A, 0xFE, 0x8D, 0x39, 0x6F, 0xA7, 0xF6, 0xA2, 0x67,
+    0xA0, 0x09, 0x74, 0x58, 0xFB, 0x08, 0x7A, 0x80, 0xB4, 0x8B, 0xDA, 0x7C,
+    0xCA, 0xCC, 0x45, 0x5A, 0xC9, 0x45, 0x66, 0x2B, 0x9A, 0x3B, 0x86, 0xD0,
+    0xBB, 0x4D, 0xEE, 0x3D, 0xA7, 0x3E, 0xBC, 0x79, 0x89, 0x22, 0xCD, 0xAD,
+    0xC0, 0x3F, 0x93, 0x5E, 0x65, 0x94, 0x0B, 0x4E, 0xA2, 0x20, 0x70, 0xFB,
+    0x77, 0xA2, 0x0C, 0x2A, 0x14, 0x77, 0xC6, 0x7B, 0x9D, 0x37, 0xE9, 0x41,
+    0xA3, 0xD9, 0x44, 0x85, 0x44, 0x6D, 0xB2, 0x83, 0xB0, 0x97, 0x0D, 0x4C,
+    0x44, 0x1D, 0x82, 0x7F, 0x21, 0x8E, 0xB6, 0xC2, 0x3F, 0x93, 0xF5, 0x39,
+    0xFD, 0x46, 0xF2, 0x31, 0xE9, 0xC2, 0x84, 0xED, 0xFA, 0x6B, 0xA2, 0x6F,
+    0x80, 0xEA, 0xEF, 0xD9, 0x58, 0x1C, 0xA2, 0x2A, 0x27, 0xC6, 0xA1, 0x82,
+    0x90, 0x17, 0xA7, 0x3F, 0x1B, 0x17, 0x4F, 0x3F, 0x07, 0x7F, 0x09, 0x3F,
+    0x07, 0x17, 0x45, 0x3F, 0x04, 0x7F, 0x17, 0x3F, 0x04, 0x17, 0x3F, 0x3F,
+    0x02, 0x7F, 0x1F, 0x3F, 0x02, 0x17, 0x3D, 0x3F, 0x02, 0x7F, 0x1F, 0x3F,
+    0x02, 0x17, 0x3D, 0x3F, 0x02, 0x7F, 0x1F, 0x3F, 0x02, 0x17, 0x3F, 0x3F,
+    0x04, 0x7F, 0x17, 0x3F, 0x04, 0x17, 0x45, 0x3F, 0x07, 0x7F, 0x09, 0x3F,
+    0x07, 0x17, 0x4F, 0x3F, 0x1B, 0x17, 0x26,
+};
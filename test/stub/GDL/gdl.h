@@ -0,0 +1,115 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+#ifndef __WARCOMEB_SSD1327ZB_STUB_GDL_H
+#define __WARCOMEB_SSD1327ZB_STUB_GDL_H
+
+/*
+ * Minimal GDL interface used to build the driver on a host machine.
+ * The drawing functions are the per-pixel reference of stub/gdl.c.
+ */
+
+#include "libohiboard.h"
+
+#define GDL_MODELTYPE_SSD1327ZB                0x0100
+
+typedef enum _GDL_Errors
+{
+    GDL_ERRORS_OK             = 0,
+    GDL_ERRORS_WRONG_POSITION = 1,
+    GDL_ERRORS_WRONG_VALUE    = 2,
+} GDL_Errors;
+
+typedef enum _GDL_PictureType
+{
+    GDL_PICTURETYPE_1BIT = 1,
+    GDL_PICTURETYPE_4BIT = 4,
+} GDL_PictureType;
+
+/**
+ * Callback that draw a pixel, the first argument is the driver device.
+ */
+typedef GDL_Errors (*GDL_DrawPixelCallback) (void* dev,
+                                             uint8_t xPos,
+                                             uint8_t yPos,
+                                             uint8_t color);
+
+typedef struct _GDL_Device
+{
+    uint16_t model;
+    uint16_t product;
+    uint16_t width;
+    uint16_t height;
+
+    uint8_t fontSize;
+    bool useCustomFont;
+    const void* customFont;            /**< Used when useCustomFont is TRUE */
+
+    /** Set by the driver, called as GDL_DrawPixelCallback */
+    void* drawPixel;
+    void (*delayTime) (uint32_t ms);
+
+#if defined WARCOMEB_GDL_PARALLEL
+    Gpio_Pins d0, d1, d2, d3, d4, d5, d6, d7;
+    Gpio_Pins rd, dc, rs, cs, wr;
+#endif
+} GDL_Device;
+
+void GDL_drawLine (GDL_Device* dev,
+                   uint16_t xStart,
+                   uint16_t yStart,
+                   uint16_t xStop,
+                   uint16_t yStop,
+                   uint8_t color);
+
+void GDL_drawRectangle (GDL_Device* dev,
+                        uint16_t xStart,
+                        uint16_t yStart,
+                        uint16_t width,
+                        uint16_t height,
+                        uint8_t color,
+                        bool isFill);
+
+GDL_Errors GDL_drawChar (GDL_Device* dev,
+                         uint16_t xPos,
+                         uint16_t yPos,
+                         uint8_t c,
+                         uint8_t color,
+                         uint8_t background,
+                         uint8_t size);
+
+GDL_Errors GDL_drawPicture (GDL_Device* dev,
+                            uint16_t xPos,
+                            uint16_t yPos,
+                            uint16_t width,
+                            uint16_t height,
+                            const uint8_t* picture,
+                            GDL_PictureType pixelType);
+
+#endif /* __WARCOMEB_SSD1327ZB_STUB_GDL_H */
@@ -0,0 +1,166 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Per-pixel reference of the GDL drawing functions: every pixel is drawn
+ * with the callback of the driver, as the generic library does.
+ */
+
+#include "GDL/gdl.h"
+
+#define GDL_CHAR_WIDTH                         6
+#define GDL_CHAR_HEIGHT                        8
+
+static GDL_Errors GDL_drawPixel (GDL_Device* dev,
+                                 uint16_t xPos,
+                                 uint16_t yPos,
+                                 uint8_t color)
+{
+    if ((xPos >= dev->width) || (yPos >= dev->height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    return ((GDL_DrawPixelCallback) dev->drawPixel)(dev,xPos,yPos,color);
+}
+
+void GDL_drawLine (GDL_Device* dev,
+                   uint16_t xStart,
+                   uint16_t yStart,
+                   uint16_t xStop,
+                   uint16_t yStop,
+                   uint8_t color)
+{
+    int16_t dx = (xStop > xStart) ? (xStop - xStart) : (xStart - xStop);
+    int16_t dy = (yStop > yStart) ? (yStart - yStop) : (yStop - yStart);
+    int8_t xStep = (xStart < xStop) ? 1 : -1;
+    int8_t yStep = (yStart < yStop) ? 1 : -1;
+    int16_t error = dx + dy;
+
+    for (int16_t x = xStart, y = yStart;;)
+    {
+        GDL_drawPixel(dev,x,y,color);
+        if ((x == xStop) && (y == yStop)) break;
+
+        int16_t error2 = 2 * error;
+        if (error2 >= dy)
+        {
+            error += dy;
+            x += xStep;
+        }
+        if (error2 <= dx)
+        {
+            error += dx;
+            y += yStep;
+        }
+    }
+}
+
+void GDL_drawRectangle (GDL_Device* dev,
+                        uint16_t xStart,
+                        uint16_t yStart,
+                        uint16_t width,
+                        uint16_t height,
+                        uint8_t color,
+                        bool isFill)
+{
+    for (uint16_t y = yStart; y < (yStart + height); ++y)
+    {
+        for (uint16_t x = xStart; x < (xStart + width); ++x)
+        {
+            bool isBorder = (y == yStart) || (y == (yStart + height - 1)) ||
+                            (x == xStart) || (x == (xStart + width - 1));
+            if (isFill || isBorder)
+                GDL_drawPixel(dev,x,y,color);
+        }
+    }
+}
+
+GDL_Errors GDL_drawChar (GDL_Device* dev,
+                         uint16_t xPos,
+                         uint16_t yPos,
+                         uint8_t c,
+                         uint8_t color,
+                         uint8_t background,
+                         uint8_t size)
+{
+    if (size == 0) size = 1;
+
+    // Only whole glyphs are drawn
+    if (((xPos + (GDL_CHAR_WIDTH * size)) > dev->width) ||
+        ((yPos + (GDL_CHAR_HEIGHT * size)) > dev->height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    // A made-up font: every character has its own pattern, the last
+    // column is the space between characters. A custom font is a byte
+    // that moves the patterns.
+    uint8_t shift = 0;
+    if (dev->useCustomFont && (dev->customFont != 0))
+        shift = *(const uint8_t*) dev->customFont;
+
+    for (uint16_t j = 0; j < (GDL_CHAR_HEIGHT * size); ++j)
+    {
+        for (uint16_t i = 0; i < (GDL_CHAR_WIDTH * size); ++i)
+        {
+            uint8_t column = i / size;
+            uint8_t row = j / size;
+            bool isSet = (column < (GDL_CHAR_WIDTH - 1)) &&
+                         ((((c * 7) + (column * 3) + (row * 5) + shift) % 4) == 0);
+            GDL_drawPixel(dev,xPos+i,yPos+j,(isSet) ? color : background);
+        }
+    }
+    return GDL_ERRORS_OK;
+}
+
+GDL_Errors GDL_drawPicture (GDL_Device* dev,
+                            uint16_t xPos,
+                            uint16_t yPos,
+                            uint16_t width,
+                            uint16_t height,
+                            const uint8_t* picture,
+                            GDL_PictureType pixelType)
+{
+    for (uint16_t y = 0; y < height; ++y)
+    {
+        for (uint16_t x = 0; x < width; ++x)
+        {
+            uint8_t color;
+            if (pixelType == GDL_PICTURETYPE_1BIT)
+            {
+                uint8_t value = picture[(y * ((width + 7)/8)) + (x/8)];
+                color = (value & (0x80 >> (x%8))) ? 15 : 0;
+            }
+            else
+            {
+                uint8_t value = picture[(y * ((width + 1)/2)) + (x/2)];
+                color = (x%2) ? (value & 0x0F) : (value >> 4);
+            }
+            GDL_drawPixel(dev,xPos+x,yPos+y,color);
+        }
+    }
+    return GDL_ERRORS_OK;
+}
@@ -0,0 +1,78 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+#ifndef __WARCOMEB_SSD1327ZB_STUB_LIBOHIBOARD_H
+#define __WARCOMEB_SSD1327ZB_STUB_LIBOHIBOARD_H
+
+/*
+ * Minimal libohiboard interface used to build the driver on a host machine.
+ * The functions are implemented by the mock bus of the tests.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+typedef uint8_t bool;
+#define TRUE                                   1
+#define FALSE                                  0
+
+typedef enum _System_Errors
+{
+    ERRORS_NO_ERROR = 0,
+} System_Errors;
+
+typedef enum _Gpio_Pins
+{
+    GPIO_PINS_NONE = 0,
+    GPIO_PINS_PTA0, GPIO_PINS_PTA1, GPIO_PINS_PTA2, GPIO_PINS_PTA3,
+    GPIO_PINS_PTA4, GPIO_PINS_PTA5, GPIO_PINS_PTA6, GPIO_PINS_PTA7,
+    GPIO_PINS_PTB0, GPIO_PINS_PTB1, GPIO_PINS_PTB2, GPIO_PINS_PTB3,
+    GPIO_PINS_PTB4, GPIO_PINS_PTB5, GPIO_PINS_PTB6, GPIO_PINS_PTB7,
+    GPIO_PINS_COUNT,
+} Gpio_Pins;
+
+#define GPIO_PINS_OUTPUT                       0x0004
+
+void Gpio_set (Gpio_Pins pin);
+void Gpio_clear (Gpio_Pins pin);
+void Gpio_toggle (Gpio_Pins pin);
+System_Errors Gpio_config (Gpio_Pins pin, uint16_t options);
+
+typedef struct _Spi_Device* Spi_DeviceHandle;
+
+System_Errors Spi_writeByte (Spi_DeviceHandle dev, uint8_t data);
+
+typedef struct _Iic_Device* Iic_DeviceHandle;
+
+System_Errors Iic_start (Iic_DeviceHandle dev);
+System_Errors Iic_stop (Iic_DeviceHandle dev);
+System_Errors Iic_writeByte (Iic_DeviceHandle dev, uint8_t data);
+
+#endif /* __WARCOMEB_SSD1327ZB_STUB_LIBOHIBOARD_H */
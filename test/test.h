@@ -0,0 +1,139 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+#ifndef __WARCOMEB_SSD1327ZB_TEST_H
+#define __WARCOMEB_SSD1327ZB_TEST_H
+
+/*
+ * Helpers shared by the host tests. The device is connected to the panel
+ * of the mock bus with the transport selected at build time.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ssd1327zb.h"
+#include "mockbus.h"
+
+static int Test_failures = 0;
+
+#define TEST_CHECK(condition) do {                                          \
+    if (!(condition))                                                       \
+    {                                                                       \
+        printf("%s:%d: check failed: %s\n",__FILE__,__LINE__,#condition);   \
+        Test_failures++;                                                    \
+    }                                                                       \
+    } while (0)
+
+/**
+ * The function print the result of the test and return the exit code.
+ */
+static inline int Test_end (const char* name)
+{
+    printf("%s: %s\n",name,(Test_failures == 0) ? "ok" : "FAILED");
+    return (Test_failures == 0) ? 0 : 1;
+}
+
+/**
+ * The function connect a device to the mock bus and initialize it.
+ *
+ * @return The result of SSD1327ZB_init.
+ */
+static inline GDL_Errors Test_initDevice (SSD1327ZB_Device* dev)
+{
+    MockBus_init();
+
+    dev->gdl.delayTime = MockBus_delay;
+    dev->gdl.product = SSD1327ZB_PRODUCT_RAYSTAR_REX128128B;
+
+#if defined WARCOMEB_SSD1327ZB_EMULATOR
+    dev->emulator = &MockBus_panel;
+#elif defined WARCOMEB_GDL_PARALLEL
+    dev->gdl.d0 = GPIO_PINS_PTA0;
+    dev->gdl.d1 = GPIO_PINS_PTA1;
+    dev->gdl.d2 = GPIO_PINS_PTA2;
+    dev->gdl.d3 = GPIO_PINS_PTA3;
+    dev->gdl.d4 = GPIO_PINS_PTA4;
+    dev->gdl.d5 = GPIO_PINS_PTA5;
+    dev->gdl.d6 = GPIO_PINS_PTA6;
+    dev->gdl.d7 = GPIO_PINS_PTA7;
+    dev->gdl.rd = MOCKBUS_PIN_RD;
+    dev->gdl.dc = MOCKBUS_PIN_DC;
+    dev->gdl.rs = MOCKBUS_PIN_RS;
+    dev->gdl.cs = MOCKBUS_PIN_CS;
+    dev->gdl.wr = MOCKBUS_PIN_WR;
+#elif defined WARCOMEB_GDL_SPI
+    dev->csPin = MOCKBUS_PIN_CS;
+    dev->dcPin = MOCKBUS_PIN_DC;
+    dev->rstPin = MOCKBUS_PIN_RST;
+#elif defined WARCOMEB_GDL_I2C
+    dev->address = 0;
+    dev->rstPin = MOCKBUS_PIN_RST;
+#endif
+
+    GDL_Errors error = SSD1327ZB_init(dev);
+    MockBus_resetCounters();
+    return error;
+}
+
+/**
+ * The function return the gray level of a pixel shown by the panel: the
+ * rows shown start from the start line of the panel memory.
+ */
+static inline uint8_t Test_getPanelPixel (uint8_t x, uint8_t y)
+{
+    return MockBus_getPixel(x,(y + MockBus_panel.startLine) % SSD1327ZB_EMULATOR_ROWS);
+}
+
+/**
+ * The function return the number of pixels shown by the panel different
+ * from the buffer of a device that holds the whole frame. With the scroll
+ * the rows of the buffer are a ring, moved as the start line of the panel.
+ */
+static inline uint32_t Test_comparePanel (SSD1327ZB_Device* dev)
+{
+    uint32_t errors = 0;
+    for (uint16_t y = 0; y < dev->gdl.height; ++y)
+    {
+#if defined WARCOMEB_SSD1327ZB_SCROLL
+        uint16_t row = (y + dev->scrollOffset) % dev->gdl.height;
+#else
+        uint16_t row = y;
+#endif
+        for (uint16_t x = 0; x < dev->gdl.width; ++x)
+        {
+            uint8_t value = dev->buffer[(row * (dev->gdl.width/2)) + (x/2)];
+            value = (x%2) ? (value >> 4) : (value & 0x0F);
+            if (value != Test_getPanelPixel(x,y)) errors++;
+        }
+    }
+    return errors;
+}
+
+#endif /* __WARCOMEB_SSD1327ZB_TEST_H */
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+
+/*
+ * Band buffer: a user buffer that holds only some rows of the display. The
+ * screen drawn band by band must be the same of a whole frame, also with a
+ * last band shorter than the others.
+ */
+
+#include "test.h"
+
+static SSD1327ZB_Device dev;
+
+/** 24 rows and some spare bytes: the last band holds only 8 rows */
+static uint8_t band [24*64 + 10];
+
+static const struct
+{
+    uint8_t x, y, width, height, color;
+} rectangles[] =
+{
+    {  0,   0, 128, 128,  1},
+    {  3,  20,  50,  10,  7},
+    { 60,  22,   9, 100, 12},
+    { 17, 110, 111,  18, 15},
+    {127, 127,   1,   1,  9},
+};
+
+static void Test_drawScreen (SSD1327ZB_Device* dev, void* context)
+{
+    (*(uint8_t*)context)++;
+    for (uint8_t i = 0; i < sizeof(rectangles)/sizeof(rectangles[0]); ++i)
+    {
+        SSD1327ZB_drawRectangle(dev,rectangles[i].x,rectangles[i].y,
+                                rectangles[i].width,rectangles[i].height,
+                                rectangles[i].color,TRUE);
+    }
+}
+
+/**
+ * The function return the number of pixels of the panel different from
+ * the screen of Test_drawScreen.
+ */
+static uint32_t Test_compareScreen (void)
+{
+    uint32_t errors = 0;
+    for (uint8_t y = 0; y < 128; ++y)
+    {
+        for (uint8_t x = 0; x < 128; ++x)
+        {
+            uint8_t color = 0;
+            for (uint8_t i = 0; i < sizeof(rectangles)/sizeof(rectangles[0]); ++i)
+            {
+                if ((x >= rectangles[i].x) && (x < (rectangles[i].x + rectangles[i].width)) &&
+                    (y >= rectangles[i].y) && (y < (rectangles[i].y + rectangles[i].height)))
+                    color = rectangles[i].color;
+            }
+            if (MockBus_getPixel(x,y) != color) errors++;
+        }
+    }
+    return errors;
+}
+
+int main (void)
+{
+    // A buffer smaller than a row is refused
+    memset(&dev,0,sizeof(dev));
+    dev.buffer = band;
+    dev.bufferSize = 63;
+    TEST_CHECK(Test_initDevice(&dev) == GDL_ERRORS_WRONG_VALUE);
+    dev.buffer = 0;
+    dev.bufferSize = sizeof(band);
+    TEST_CHECK(Test_initDevice(&dev) == GDL_ERRORS_WRONG_VALUE);
+
+    memset(&dev,0,sizeof(dev));
+    dev.buffer = band;
+    dev.bufferSize = sizeof(band);
+    TEST_CHECK(Test_initDevice(&dev) == GDL_ERRORS_OK);
+    TEST_CHECK(dev.bandRows == 24);
+
+    // An incremental flush is dropped when the band changes
+    SSD1327ZB_drawRectangle(&dev,0,0,128,20,SSD1327ZB_GRAYSCALE_5,TRUE);
+    SSD1327ZB_flushBegin(&dev);
+    SSD1327ZB_flushStep(&dev,100);
+    TEST_CHECK(SSD1327ZB_flushBusy(&dev));
+
+    uint8_t calls = 0;
+    SSD1327ZB_render(&dev,Test_drawScreen,&calls);
+    TEST_CHECK(calls == 6);
+    TEST_CHECK(!SSD1327ZB_flushBusy(&dev));
+    TEST_CHECK(Test_compareScreen() == 0);
+
+    // The last band stays selected and its window ends on the last row
+    TEST_CHECK(dev.bandStart == 120);
+    SSD1327ZB_flush(&dev);
+    TEST_CHECK(MockBus_panel.rowStop == 127);
+    TEST_CHECK(Test_compareScreen() == 0);
+
+    SSD1327ZB_clear(&dev);
+    TEST_CHECK(dev.bandStart == 0);
+    uint32_t lit = 0;
+    for (uint8_t y = 0; y < 128; ++y)
+    {
+        for (uint8_t x = 0; x < 128; ++x)
+        {
+            if (MockBus_getPixel(x,y) != 0) lit++;
+        }
+    }
+    TEST_CHECK(lit == 0);
+
+    return Test_end("band");
+}
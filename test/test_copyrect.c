@@ -0,0 +1,248 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Rectangle copy: SSD1327ZB_copyRect and SSD1327ZB_moveRect must give the
+ * same pixels of a per-pixel reference for odd and even offsets, for
+ * source and destination that overlap in every direction and for
+ * rectangles that touch the edges of the display, and must mark dirty
+ * every changed pixel.
+ */
+
+#include "test.h"
+
+#define TEST_WIDTH                               128
+#define TEST_HEIGHT                              128
+#define TEST_STRIDE                              (TEST_WIDTH/2)
+
+static SSD1327ZB_Device dev;
+static uint8_t reference [TEST_HEIGHT*TEST_STRIDE];
+static uint8_t source [TEST_HEIGHT*TEST_STRIDE];
+
+static uint32_t Test_seed = 0x2545F491u;
+
+static uint32_t Test_random (uint32_t limit)
+{
+    Test_seed ^= Test_seed << 13;
+    Test_seed ^= Test_seed >> 17;
+    Test_seed ^= Test_seed << 5;
+    return Test_seed % limit;
+}
+
+static uint8_t Test_getPixel (const uint8_t* frame, uint8_t x, uint8_t y)
+{
+    uint8_t value = frame[(y * TEST_STRIDE) + (x/2)];
+    return (x%2) ? (value >> 4) : (value & 0x0F);
+}
+
+static void Test_setPixel (uint8_t* frame, uint8_t x, uint8_t y, uint8_t color)
+{
+    uint8_t* pixel = &frame[(y * TEST_STRIDE) + (x/2)];
+    if (x%2)
+        *pixel = (uint8_t)(color << 4) | (*pixel & 0x0F);
+    else
+        *pixel = (color & 0x0F) | (*pixel & 0xF0);
+}
+
+/**
+ * The function fill the buffer and the reference with the same pixels.
+ */
+static void Test_fill (void)
+{
+    for (uint16_t i = 0; i < sizeof(reference); ++i)
+    {
+        reference[i] = (uint8_t) Test_random(256);
+    }
+    memcpy(dev.buffer,reference,sizeof(reference));
+    dev.dirtyCount = 0;
+}
+
+/**
+ * The function pick the source and the destination of a rectangle. Half
+ * of the times the destination is near the source, so the two overlap.
+ */
+static void Test_area (uint8_t* xSrc, uint8_t* ySrc, uint8_t* width, uint8_t* height,
+                       uint8_t* xDst, uint8_t* yDst)
+{
+    *width = 1 + Test_random(TEST_WIDTH);
+    *height = 1 + Test_random(TEST_HEIGHT);
+    if (Test_random(2))
+    {
+        *width = 1 + Test_random(40);
+        *height = 1 + Test_random(40);
+    }
+    *xSrc = Test_random(TEST_WIDTH - *width + 1);
+    *ySrc = Test_random(TEST_HEIGHT - *height + 1);
+
+    if (Test_random(2))
+    {
+        int16_t x = *xSrc + (int16_t) Test_random(17) - 8;
+        int16_t y = *ySrc + (int16_t) Test_random(17) - 8;
+        if (x < 0) x = 0;
+        if (y < 0) y = 0;
+        if ((x + *width) > TEST_WIDTH) x = TEST_WIDTH - *width;
+        if ((y + *height) > TEST_HEIGHT) y = TEST_HEIGHT - *height;
+        *xDst = (uint8_t) x;
+        *yDst = (uint8_t) y;
+    }
+    else
+    {
+        *xDst = Test_random(TEST_WIDTH - *width + 1);
+        *yDst = Test_random(TEST_HEIGHT - *height + 1);
+    }
+}
+
+/**
+ * @return TRUE when a pixel is into one of the dirty areas.
+ */
+static bool Test_isDirty (uint8_t x, uint8_t y)
+{
+    for (uint8_t i = 0; i < dev.dirtyCount; ++i)
+    {
+        if ((x >= dev.dirty[i].xStart) && (x <= dev.dirty[i].xStop) &&
+            (y >= dev.dirty[i].yStart) && (y <= dev.dirty[i].yStop))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * The function apply the copy or the move to the reference, reading every
+ * pixel from a copy of the frame taken before.
+ *
+ * @param[in] isMove TRUE to fill the uncovered source with the background
+ */
+static void Test_apply (bool isMove, uint8_t xSrc, uint8_t ySrc, uint8_t width, uint8_t height,
+                        uint8_t xDst, uint8_t yDst, uint8_t background)
+{
+    memcpy(source,reference,sizeof(reference));
+    if (isMove)
+    {
+        for (uint16_t y = ySrc; y < (ySrc + height); ++y)
+        {
+            for (uint16_t x = xSrc; x < (xSrc + width); ++x)
+            {
+                Test_setPixel(reference,x,y,background);
+            }
+        }
+    }
+    for (uint16_t y = 0; y < height; ++y)
+    {
+        for (uint16_t x = 0; x < width; ++x)
+        {
+            Test_setPixel(reference,xDst + x,yDst + y,Test_getPixel(source,xSrc + x,ySrc + y));
+        }
+    }
+}
+
+/**
+ * @return The number of wrong bytes, plus the changed pixels not dirty.
+ */
+static uint32_t Test_compare (const char* name, uint8_t xSrc, uint8_t ySrc,
+                              uint8_t width, uint8_t height, uint8_t xDst, uint8_t yDst)
+{
+    uint32_t errors = 0;
+    uint32_t clean = 0;
+    for (uint16_t i = 0; i < sizeof(reference); ++i)
+    {
+        if (dev.buffer[i] != reference[i]) errors++;
+    }
+    for (uint16_t y = 0; y < TEST_HEIGHT; ++y)
+    {
+        for (uint16_t x = 0; x < TEST_WIDTH; ++x)
+        {
+            if ((Test_getPixel(source,x,y) != Test_getPixel(reference,x,y)) && !Test_isDirty(x,y))
+                clean++;
+        }
+    }
+    if ((errors != 0) || (clean != 0))
+        printf("%s (%u,%u) %ux%u to (%u,%u): %u bytes differ, %u pixels not dirty\n",
+               name,xSrc,ySrc,width,height,xDst,yDst,errors,clean);
+    return errors + clean;
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+
+    uint32_t wrong = 0;
+    for (uint16_t i = 0; i < 4000; ++i)
+    {
+        uint8_t xSrc, ySrc, width, height, xDst, yDst;
+        Test_area(&xSrc,&ySrc,&width,&height,&xDst,&yDst);
+
+        Test_fill();
+        TEST_CHECK(SSD1327ZB_copyRect(&dev,xSrc,ySrc,width,height,xDst,yDst) == GDL_ERRORS_OK);
+        Test_apply(FALSE,xSrc,ySrc,width,height,xDst,yDst,0);
+        if ((Test_compare("copyRect",xSrc,ySrc,width,height,xDst,yDst) != 0) && (++wrong > 10)) break;
+
+        uint8_t background = Test_random(16);
+        Test_fill();
+        TEST_CHECK(SSD1327ZB_moveRect(&dev,xSrc,ySrc,width,height,xDst,yDst,background) == GDL_ERRORS_OK);
+        Test_apply(TRUE,xSrc,ySrc,width,height,xDst,yDst,background);
+        if ((Test_compare("moveRect",xSrc,ySrc,width,height,xDst,yDst) != 0) && (++wrong > 10)) break;
+    }
+    TEST_CHECK(wrong == 0);
+
+    // Every direction by one column or row, with odd and even columns
+    wrong = 0;
+    const int8_t steps [8][2] = {{1,0},{-1,0},{0,1},{0,-1},{1,1},{-1,-1},{1,-1},{-1,1}};
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        for (uint8_t x = 1; x < 3; ++x)
+        {
+            for (uint8_t width = 1; width < 6; ++width)
+            {
+                Test_fill();
+                SSD1327ZB_moveRect(&dev,x,1,width,4,x + steps[i][0],1 + steps[i][1],0x0F);
+                Test_apply(TRUE,x,1,width,4,x + steps[i][0],1 + steps[i][1],0x0F);
+                if (Test_compare("moveRect",x,1,width,4,x + steps[i][0],1 + steps[i][1]) != 0) wrong++;
+            }
+        }
+    }
+    TEST_CHECK(wrong == 0);
+
+    // The whole display moved by one column: the oscilloscope scroll
+    Test_fill();
+    TEST_CHECK(SSD1327ZB_moveRect(&dev,1,0,TEST_WIDTH-1,TEST_HEIGHT,0,0,0) == GDL_ERRORS_OK);
+    Test_apply(TRUE,1,0,TEST_WIDTH-1,TEST_HEIGHT,0,0,0);
+    TEST_CHECK(Test_compare("moveRect",1,0,TEST_WIDTH-1,TEST_HEIGHT,0,0) == 0);
+
+    // Rectangles out of the display are refused and leave the buffer untouched
+    Test_fill();
+    TEST_CHECK(SSD1327ZB_copyRect(&dev,TEST_WIDTH-7,0,8,8,0,0) == GDL_ERRORS_WRONG_POSITION);
+    TEST_CHECK(SSD1327ZB_copyRect(&dev,0,0,8,8,0,TEST_HEIGHT-7) == GDL_ERRORS_WRONG_POSITION);
+    TEST_CHECK(SSD1327ZB_moveRect(&dev,0,TEST_HEIGHT-7,8,8,0,0,0) == GDL_ERRORS_WRONG_POSITION);
+    TEST_CHECK(SSD1327ZB_moveRect(&dev,0,0,8,8,TEST_WIDTH-7,0,0) == GDL_ERRORS_WRONG_POSITION);
+    TEST_CHECK(memcmp(dev.buffer,reference,sizeof(reference)) == 0);
+    TEST_CHECK(dev.dirtyCount == 0);
+
+    return Test_end("copyrect");
+}
@@ -0,0 +1,179 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Dirty areas: SSD1327ZB_markDirty must merge the areas only when a single
+ * window is cheaper, keep every marked pixel into the list when the list is
+ * full, and SSD1327ZB_flushDirty must send less than a full flush while
+ * bringing the panel to the buffer.
+ */
+
+#include "test.h"
+
+static SSD1327ZB_Device dev;
+
+static uint32_t Test_seed = 0x1B873593u;
+
+static uint32_t Test_random (uint32_t limit)
+{
+    Test_seed ^= Test_seed << 13;
+    Test_seed ^= Test_seed >> 17;
+    Test_seed ^= Test_seed << 5;
+    return Test_seed % limit;
+}
+
+/**
+ * @return TRUE when the list holds a single area with these bounds.
+ */
+static bool Test_isSingle (uint8_t xStart, uint8_t xStop, uint8_t yStart, uint8_t yStop)
+{
+    return (dev.dirtyCount == 1) &&
+           (dev.dirty[0].xStart == xStart) && (dev.dirty[0].xStop == xStop) &&
+           (dev.dirty[0].yStart == yStart) && (dev.dirty[0].yStop == yStop);
+}
+
+/**
+ * @return TRUE when a pixel is into one of the dirty areas.
+ */
+static bool Test_isDirty (uint8_t x, uint8_t y)
+{
+    for (uint8_t i = 0; i < dev.dirtyCount; ++i)
+    {
+        if ((x >= dev.dirty[i].xStart) && (x <= dev.dirty[i].xStop) &&
+            (y >= dev.dirty[i].yStart) && (y <= dev.dirty[i].yStop))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+    SSD1327ZB_flush(&dev);
+
+    // Odd bounds are rounded to whole column pairs, the rest is clipped
+    dev.dirtyCount = 0;
+    SSD1327ZB_markDirty(&dev,3,3,5,5);
+    TEST_CHECK(Test_isSingle(2,3,5,5));
+    dev.dirtyCount = 0;
+    SSD1327ZB_markDirty(&dev,120,300,100,200);
+    TEST_CHECK(Test_isSingle(120,127,100,127));
+    dev.dirtyCount = 0;
+    SSD1327ZB_markDirty(&dev,128,130,0,0);
+    SSD1327ZB_markDirty(&dev,10,5,0,0);
+    TEST_CHECK(dev.dirtyCount == 0);
+
+    // Adjacent areas
+    dev.dirtyCount = 0;
+    SSD1327ZB_markDirty(&dev,0,9,0,9);
+    SSD1327ZB_markDirty(&dev,10,19,0,9);
+    TEST_CHECK(Test_isSingle(0,19,0,9));
+    SSD1327ZB_markDirty(&dev,0,19,10,19);
+    TEST_CHECK(Test_isSingle(0,19,0,19));
+
+    // Overlapping and contained areas
+    dev.dirtyCount = 0;
+    SSD1327ZB_markDirty(&dev,0,19,0,19);
+    SSD1327ZB_markDirty(&dev,4,23,2,21);
+    TEST_CHECK(Test_isSingle(0,23,0,21));
+    SSD1327ZB_markDirty(&dev,5,6,7,8);
+    TEST_CHECK(Test_isSingle(0,23,0,21));
+
+    // Near areas: the gap costs less than a window
+    dev.dirtyCount = 0;
+    SSD1327ZB_markDirty(&dev,0,3,40,40);
+    SSD1327ZB_markDirty(&dev,6,9,40,40);
+    TEST_CHECK(Test_isSingle(0,9,40,40));
+
+    // Far areas are kept apart
+    dev.dirtyCount = 0;
+    SSD1327ZB_markDirty(&dev,0,1,0,0);
+    SSD1327ZB_markDirty(&dev,120,127,120,127);
+    TEST_CHECK(dev.dirtyCount == 2);
+
+    // An area that joins two stored areas: all of them become one
+    dev.dirtyCount = 0;
+    SSD1327ZB_markDirty(&dev,0,31,0,3);
+    SSD1327ZB_markDirty(&dev,0,31,8,11);
+    TEST_CHECK(dev.dirtyCount == 2);
+    SSD1327ZB_markDirty(&dev,0,31,4,7);
+    TEST_CHECK(Test_isSingle(0,31,0,11));
+
+    // A full list: the new area is merged with the one that grows less
+    dev.dirtyCount = 0;
+    const uint8_t corners [][2] = {{0,0}, {126,0}, {0,126}, {126,126}, {100,110}};
+    for (uint8_t i = 0; i < 5; ++i)
+    {
+        SSD1327ZB_markDirty(&dev,corners[i][0],corners[i][0]+1,corners[i][1],corners[i][1]+1);
+    }
+    TEST_CHECK(dev.dirtyCount == WARCOMEB_SSD1327ZB_DIRTY_AREAS);
+    for (uint8_t i = 0; i < 5; ++i)
+    {
+        TEST_CHECK(Test_isDirty(corners[i][0],corners[i][1]));
+        TEST_CHECK(Test_isDirty(corners[i][0]+1,corners[i][1]+1));
+    }
+    TEST_CHECK(Test_isDirty(0,0) && !Test_isDirty(50,50));
+
+    // Many random pixels: the list never grows over its size and every
+    // pixel is flushed
+    dev.dirtyCount = 0;
+    for (uint16_t i = 0; i < 300; ++i)
+    {
+        uint8_t x = Test_random(128), y = Test_random(128);
+        SSD1327ZB_drawPixel(&dev,x,y,(SSD1327ZB_GrayScale)(1 + Test_random(15)));
+        TEST_CHECK(dev.dirtyCount <= WARCOMEB_SSD1327ZB_DIRTY_AREAS);
+        TEST_CHECK(Test_isDirty(x,y));
+    }
+    SSD1327ZB_flushDirty(&dev);
+    TEST_CHECK(dev.dirtyCount == 0);
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    // A few small changes: the dirty flush sends much less than a full
+    // flush, and the panel is the same
+    SSD1327ZB_drawPixel(&dev,5,5,SSD1327ZB_GRAYSCALE_3);
+    SSD1327ZB_drawHLine(&dev,60,64,20,SSD1327ZB_GRAYSCALE_8);
+    SSD1327ZB_drawRectangle(&dev,100,100,8,8,SSD1327ZB_GRAYSCALE_12,TRUE);
+    MockBus_resetCounters();
+    SSD1327ZB_flushDirty(&dev);
+    uint32_t dirtyBytes = MockBus_panel.counters.dataBytes + MockBus_panel.counters.commandBytes;
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+    // 1 + 11 + 32 data bytes, 6 command bytes for every window
+    TEST_CHECK(MockBus_panel.counters.dataBytes == (1 + 11 + 32));
+    TEST_CHECK(MockBus_panel.counters.commandBytes == (3 * 6));
+
+    MockBus_resetCounters();
+    SSD1327ZB_flush(&dev);
+    uint32_t fullBytes = MockBus_panel.counters.dataBytes + MockBus_panel.counters.commandBytes;
+    TEST_CHECK(fullBytes == (WARCOMEB_SSD1327ZB_BUFFERDIMENSION + 6));
+    TEST_CHECK(dirtyBytes < (fullBytes / 100));
+    printf("dirty: %u bytes against %u of a full flush\n",dirtyBytes,fullBytes);
+
+    return Test_end("dirty");
+}
@@ -0,0 +1,170 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Fades: every tick of SSD1327ZB_fadeTick must send the contrast (0x81) or
+ * the whole gray scale table (0xB8) of the next step, nothing when the
+ * value does not change, and the panel must reach the final values.
+ */
+
+#include "test.h"
+
+static SSD1327ZB_Device dev;
+
+static const uint8_t Test_linearTable [SSD1327ZB_GRAYTABLE_SIZE] =
+{
+    2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30,
+};
+
+static const uint8_t Test_table [SSD1327ZB_GRAYTABLE_SIZE] =
+{
+    1, 3, 7, 12, 18, 25, 33, 41, 50, 60, 71, 83, 96, 110, 125,
+};
+
+/**
+ * The function return the value of a fade after some steps: the exact
+ * value rounded down.
+ */
+static uint8_t Test_fadeValue (uint8_t from, uint8_t to, uint16_t step, uint16_t steps)
+{
+    int32_t delta = ((int32_t) to - from) * step;
+    int32_t value = delta / steps;
+    if ((delta < 0) && ((value * steps) != delta)) value--;
+    return (uint8_t)(from + value);
+}
+
+/**
+ * The function run a contrast fade and check the bytes of every tick.
+ */
+static void Test_contrastFade (uint8_t from, uint8_t to, uint16_t steps)
+{
+    SSD1327ZB_setContrast(&dev,from);
+    MockBus_resetCounters();
+    SSD1327ZB_fadeContrast(&dev,to,steps);
+    // The start sends nothing
+    TEST_CHECK(MockBus_counters.commandBytes == 0);
+
+    uint8_t last = from;
+    for (uint16_t step = 1; step <= steps; ++step)
+    {
+        MockBus_resetCounters();
+        bool isRunning = SSD1327ZB_fadeTick(&dev);
+        TEST_CHECK(isRunning == (step < steps));
+
+        uint8_t value = Test_fadeValue(from,to,step,steps);
+        if (value == last)
+        {
+            TEST_CHECK(MockBus_counters.commandBytes == 0);
+        }
+        else
+        {
+            TEST_CHECK(MockBus_counters.commandBytes == 2);
+            TEST_CHECK(MockBus_commandLog[0] == 0x81);
+            TEST_CHECK(MockBus_commandLog[1] == value);
+        }
+        TEST_CHECK(MockBus_panel.contrast == value);
+        last = value;
+    }
+    TEST_CHECK(MockBus_panel.contrast == to);
+
+    // The fade is done
+    MockBus_resetCounters();
+    TEST_CHECK(!SSD1327ZB_fadeTick(&dev));
+    TEST_CHECK(MockBus_counters.commandBytes == 0);
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+
+    // The contrast is sent at once
+    SSD1327ZB_setContrast(&dev,0x40);
+    TEST_CHECK(MockBus_counters.commandBytes == 2);
+    TEST_CHECK((MockBus_commandLog[0] == 0x81) && (MockBus_commandLog[1] == 0x40));
+    TEST_CHECK(MockBus_panel.contrast == 0x40);
+
+    // Up, down, and slower than the change of the value
+    Test_contrastFade(0x40,0xC0,4);
+    Test_contrastFade(0xC0,0x11,7);
+    Test_contrastFade(0xC0,0xC2,10);
+    Test_contrastFade(0x05,0x00,12);
+
+    // A new value stops the fade
+    SSD1327ZB_fadeContrast(&dev,0xFF,10);
+    SSD1327ZB_fadeTick(&dev);
+    SSD1327ZB_setContrast(&dev,0x20);
+    MockBus_resetCounters();
+    TEST_CHECK(!SSD1327ZB_fadeTick(&dev));
+    TEST_CHECK(MockBus_counters.commandBytes == 0);
+    TEST_CHECK(MockBus_panel.contrast == 0x20);
+
+    // No steps: the contrast is sent at once
+    MockBus_resetCounters();
+    SSD1327ZB_fadeContrast(&dev,0x33,0);
+    TEST_CHECK((MockBus_commandLog[0] == 0x81) && (MockBus_commandLog[1] == 0x33));
+
+    // The linear table
+    MockBus_resetCounters();
+    SSD1327ZB_setLinearGrayTable(&dev);
+    TEST_CHECK((MockBus_counters.commandBytes == 1) && (MockBus_commandLog[0] == 0xB9));
+    TEST_CHECK(memcmp(MockBus_panel.grayTable,Test_linearTable,SSD1327ZB_GRAYTABLE_SIZE) == 0);
+
+    // The fade of the table: every tick sends the whole table
+    SSD1327ZB_fadeGrayTable(&dev,Test_table,5);
+    for (uint16_t step = 1; step <= 5; ++step)
+    {
+        MockBus_resetCounters();
+        TEST_CHECK(SSD1327ZB_fadeTick(&dev) == (step < 5));
+        TEST_CHECK(MockBus_counters.commandBytes == (1 + SSD1327ZB_GRAYTABLE_SIZE));
+        TEST_CHECK(MockBus_commandLog[0] == 0xB8);
+        for (uint8_t i = 0; i < SSD1327ZB_GRAYTABLE_SIZE; ++i)
+        {
+            uint8_t value = Test_fadeValue(Test_linearTable[i],Test_table[i],step,5);
+            TEST_CHECK(MockBus_commandLog[1 + i] == value);
+            TEST_CHECK(MockBus_panel.grayTable[i] == value);
+            // Both tables are strictly increasing, every step is too
+            if (i > 0)
+                TEST_CHECK(MockBus_panel.grayTable[i] > MockBus_panel.grayTable[i - 1]);
+        }
+    }
+    TEST_CHECK(memcmp(MockBus_panel.grayTable,Test_table,SSD1327ZB_GRAYTABLE_SIZE) == 0);
+
+    // Both fades at the same time: one tick sends both
+    SSD1327ZB_fadeContrast(&dev,0x90,2);
+    SSD1327ZB_fadeGrayTable(&dev,Test_linearTable,2);
+    MockBus_resetCounters();
+    TEST_CHECK(SSD1327ZB_fadeTick(&dev));
+    TEST_CHECK(MockBus_counters.commandBytes == (2 + 1 + SSD1327ZB_GRAYTABLE_SIZE));
+    TEST_CHECK(!SSD1327ZB_fadeTick(&dev));
+    TEST_CHECK(MockBus_panel.contrast == 0x90);
+    TEST_CHECK(memcmp(MockBus_panel.grayTable,Test_linearTable,SSD1327ZB_GRAYTABLE_SIZE) == 0);
+
+    return Test_end("fade");
+}
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Port-wide writes of the parallel bus (WARCOMEB_SSD1327ZB_FAST_PORT): the
+ * mapping of the data lines, the mask table and the bytes seen on the bus,
+ * compared with the per-pin path.
+ */
+
+#include "test.h"
+
+static SSD1327ZB_Device dev;
+
+/**
+ * The function send a frame with every byte value and return the number
+ * of GPIO calls and port writes for every data byte.
+ */
+static double sendFrame (void)
+{
+    for (uint16_t i = 0; i < WARCOMEB_SSD1327ZB_BUFFERDIMENSION; ++i)
+    {
+        dev.buffer[i] = (uint8_t)((i * 7) + (i >> 8));
+    }
+
+    MockBus_resetCounters();
+    SSD1327ZB_flush(&dev);
+
+    TEST_CHECK(MockBus_counters.errors == 0);
+    TEST_CHECK(MockBus_counters.dataBytes == WARCOMEB_SSD1327ZB_BUFFERDIMENSION);
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    return (double)(MockBus_counters.gpioCalls + MockBus_counters.portWrites) /
+           MockBus_counters.dataBytes;
+}
+
+static void initDevice (bool hasMapper, uint8_t shift, uint8_t otherLine, uint8_t unknownLine)
+{
+    memset(&dev,0,sizeof(dev));
+    MockBus_portShift = shift;
+    MockBus_otherLine = otherLine;
+    MockBus_unknownLine = unknownLine;
+    dev.portMapper = (hasMapper) ? MockBus_portMapper : 0;
+    Test_initDevice(&dev);
+}
+
+int main (void)
+{
+    // All the lines on one port, starting from bit 5
+    initDevice(TRUE,5,MOCKBUS_LINE_NONE,MOCKBUS_LINE_NONE);
+    TEST_CHECK(dev.portSet == &MockBus_portSet);
+    TEST_CHECK(dev.portClear == &MockBus_portClear);
+    TEST_CHECK(dev.portDataMask == ((uint32_t) 0xFF << 5));
+    for (uint16_t value = 0; value < 256; ++value)
+    {
+        uint32_t mask = dev.portLowMask[value & 0x0F] | dev.portHighMask[value >> 4];
+        TEST_CHECK(mask == ((uint32_t) value << 5));
+    }
+    double fastCost = sendFrame();
+
+    // Lines on two ports: per-pin path
+    initDevice(TRUE,0,3,MOCKBUS_LINE_NONE);
+    TEST_CHECK(dev.portSet == 0);
+    double splitCost = sendFrame();
+
+    // A line the mapper can't describe, after some lines already mapped
+    initDevice(TRUE,0,MOCKBUS_LINE_NONE,5);
+    TEST_CHECK(dev.portSet == 0);
+    TEST_CHECK(dev.portDataMask == 0);
+    sendFrame();
+
+    // No mapper
+    initDevice(FALSE,0,MOCKBUS_LINE_NONE,MOCKBUS_LINE_NONE);
+    TEST_CHECK(dev.portSet == 0);
+    double slowCost = sendFrame();
+
+    printf("bus accesses for every byte: port %.1f, split lines %.1f, per pin %.1f\n",
+           fastCost,splitCost,slowCost);
+    TEST_CHECK(fastCost < slowCost);
+
+    return Test_end("fastport");
+}
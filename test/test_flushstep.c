@@ -0,0 +1,125 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+
+/*
+ * Incremental flush: drawings are made between the steps of a flush, every
+ * step must stay into its budget with the window commands, and
+ * at the end the panel must show the buffer.
+ */
+
+#include "test.h"
+
+static SSD1327ZB_Device dev;
+
+static uint32_t Test_seed = 0x9E3779B9u;
+
+static uint8_t Test_random (uint8_t limit)
+{
+    Test_seed ^= Test_seed << 13;
+    Test_seed ^= Test_seed >> 17;
+    Test_seed ^= Test_seed << 5;
+    return (uint8_t)(Test_seed % limit);
+}
+
+static void Test_draw (void)
+{
+    uint8_t color = Test_random(16);
+    switch (Test_random(4))
+    {
+    case 0:
+        SSD1327ZB_drawRectangle(&dev,Test_random(128),Test_random(128),
+                                Test_random(40),Test_random(40),color,TRUE);
+        break;
+    case 1:
+        SSD1327ZB_drawLine(&dev,Test_random(128),Test_random(128),
+                           Test_random(128),Test_random(128),color);
+        break;
+    case 2:
+        SSD1327ZB_drawVLine(&dev,Test_random(128),Test_random(128),Test_random(128),color);
+        break;
+    default:
+        SSD1327ZB_drawPixel(&dev,Test_random(128),Test_random(128),color);
+        break;
+    }
+}
+
+/**
+ * The function send a step and check the bytes seen on the bus.
+ */
+static void Test_step (uint16_t budget)
+{
+    MockBus_resetCounters();
+    uint16_t sent = SSD1327ZB_flushStep(&dev,budget);
+    uint32_t bus = MockBus_counters.commandBytes + MockBus_counters.dataBytes;
+
+    TEST_CHECK(sent == bus);
+    TEST_CHECK(sent <= budget);
+    if ((sent != bus) || (sent > budget))
+        printf("flushstep: budget %u, sent %u, bus %u\n",budget,sent,bus);
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+    SSD1327ZB_flush(&dev);
+
+    for (uint16_t frame = 0; frame < 300; ++frame)
+    {
+        // Other windows sent between two incremental flushes
+        if ((frame % 3) == 0)
+        {
+            SSD1327ZB_drawVLine(&dev,Test_random(128),0,127,Test_random(16));
+            SSD1327ZB_flushDirty(&dev);
+        }
+
+        for (uint8_t i = 0; i < 4; ++i) Test_draw();
+
+        SSD1327ZB_flushBegin(&dev);
+        const uint16_t budget = 72 + Test_random(200);
+        while (SSD1327ZB_flushBusy(&dev))
+        {
+            Test_step(budget);
+            // The drawings go on between the steps
+            if (Test_random(2)) Test_draw();
+        }
+    }
+
+    // The changes made during the last flush are still dirty
+    SSD1327ZB_flushBegin(&dev);
+    while (SSD1327ZB_flushBusy(&dev))
+    {
+        Test_step(100);
+    }
+    TEST_CHECK(dev.dirtyCount == 0);
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    return Test_end("flushstep");
+}
@@ -0,0 +1,163 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Frame scheduler: SSD1327ZB_frameTick must send nothing before the frame
+ * interval, never more than the budget of a frame, the cheapest areas
+ * first, and every area in the end, so the panel matches the buffer.
+ */
+
+#include "test.h"
+
+#define TEST_BUDGET                              200
+
+static SSD1327ZB_Device dev;
+
+/**
+ * @return The bytes seen on the bus since the last reset.
+ */
+static uint32_t Test_busBytes (void)
+{
+    return MockBus_counters.commandBytes + MockBus_counters.dataBytes;
+}
+
+/**
+ * @return TRUE when the panel shows the buffer into an area.
+ */
+static bool Test_isShown (uint8_t xStart, uint8_t xStop, uint8_t yStart, uint8_t yStop)
+{
+    for (uint8_t y = yStart; y <= yStop; ++y)
+    {
+        for (uint8_t x = xStart; x <= xStop; ++x)
+        {
+            uint8_t value = dev.buffer[(y * 64) + (x/2)];
+            value = (x%2) ? (value >> 4) : (value & 0x0F);
+            if (value != MockBus_getPixel(x,y)) return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * The function call the tick every millisecond until nothing is left to
+ * send, checking the interval and the budget of every frame.
+ *
+ * @return The number of frames sent.
+ */
+static uint32_t Test_runFrames (uint32_t* now, uint16_t interval, uint16_t budget)
+{
+    uint32_t frames = 0;
+    uint32_t last = dev.frameStart;
+
+    for (uint32_t i = 0; i < 10000; ++i, ++(*now))
+    {
+        MockBus_resetCounters();
+        if (SSD1327ZB_frameTick(&dev,*now))
+        {
+            TEST_CHECK((uint32_t)(*now - last) >= interval);
+            if (budget != 0) TEST_CHECK(Test_busBytes() <= budget);
+            last = *now;
+            frames++;
+        }
+        else
+        {
+            TEST_CHECK(Test_busBytes() == 0);
+            if (!SSD1327ZB_flushBusy(&dev) && (dev.dirtyCount == 0) &&
+                ((uint32_t)(*now - last) >= interval))
+                break;
+        }
+    }
+    return frames;
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+    SSD1327ZB_flush(&dev);
+
+    // 50 frames per second, 200 bytes for every frame
+    SSD1327ZB_setFrameRate(&dev,50,TEST_BUDGET);
+
+    // A big area, a medium and a small one, far from each other
+    SSD1327ZB_drawRectangle(&dev,0,0,128,50,SSD1327ZB_GRAYSCALE_7,TRUE);
+    SSD1327ZB_drawRectangle(&dev,40,80,20,10,SSD1327ZB_GRAYSCALE_11,TRUE);
+    SSD1327ZB_drawPixel(&dev,100,120,SSD1327ZB_GRAYSCALE_15);
+    TEST_CHECK(dev.dirtyCount == 3);
+
+    // Nothing before the interval
+    MockBus_resetCounters();
+    TEST_CHECK(!SSD1327ZB_frameTick(&dev,5));
+    TEST_CHECK(!SSD1327ZB_frameTick(&dev,19));
+    TEST_CHECK(Test_busBytes() == 0);
+
+    // The first frame sends the cheapest areas first
+    TEST_CHECK(SSD1327ZB_frameTick(&dev,20));
+    TEST_CHECK(Test_busBytes() <= TEST_BUDGET);
+    TEST_CHECK(Test_isShown(100,101,120,120));
+    TEST_CHECK(Test_isShown(40,59,80,89));
+    TEST_CHECK(!Test_isShown(0,127,0,49));
+
+    // The next frames send the big area, within the budget
+    uint32_t now = 21;
+    uint32_t frames = Test_runFrames(&now,20,TEST_BUDGET);
+    // 64 bytes for every row, three rows for every frame
+    TEST_CHECK(frames >= ((50 + 2) / 3));
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    // Areas marked while a flush is active are sent by the next flush
+    SSD1327ZB_drawRectangle(&dev,0,60,128,40,SSD1327ZB_GRAYSCALE_2,TRUE);
+    now += 20;
+    TEST_CHECK(SSD1327ZB_frameTick(&dev,now));
+    TEST_CHECK(SSD1327ZB_flushBusy(&dev));
+    SSD1327ZB_drawPixel(&dev,1,1,SSD1327ZB_GRAYSCALE_9);
+    SSD1327ZB_drawLine(&dev,0,127,127,100,SSD1327ZB_GRAYSCALE_13);
+    Test_runFrames(&now,20,TEST_BUDGET);
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    // The clock wraps around
+    dev.frameStart = 0xFFFFFFF0u;
+    SSD1327ZB_drawPixel(&dev,5,5,SSD1327ZB_GRAYSCALE_1);
+    MockBus_resetCounters();
+    TEST_CHECK(!SSD1327ZB_frameTick(&dev,0xFFFFFFFFu));
+    TEST_CHECK(SSD1327ZB_frameTick(&dev,4));
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    // No limits: a single frame sends everything
+    SSD1327ZB_setFrameRate(&dev,0,0);
+    SSD1327ZB_drawRectangle(&dev,0,0,128,128,SSD1327ZB_GRAYSCALE_4,TRUE);
+    SSD1327ZB_drawPixel(&dev,3,3,SSD1327ZB_GRAYSCALE_8);
+    MockBus_resetCounters();
+    TEST_CHECK(SSD1327ZB_frameTick(&dev,now));
+    TEST_CHECK(!SSD1327ZB_flushBusy(&dev));
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+    TEST_CHECK(!SSD1327ZB_frameTick(&dev,now));
+
+    return Test_end("frame");
+}
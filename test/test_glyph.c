@@ -0,0 +1,125 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Glyph cache: the strings drawn from the cache must have the same pixels
+ * of the chars drawn by GDL, also when the cache has less slots than the
+ * chars of the string and when the custom font is changed.
+ */
+
+#include "test.h"
+
+static SSD1327ZB_Device dev;
+static SSD1327ZB_Device reference;
+
+static const uint8_t fontA = 1;
+static const uint8_t fontB = 2;
+
+/**
+ * The function draw a string with the cache and char by char through GDL
+ * with the reference device, and return the number of different bytes.
+ */
+static uint32_t Test_compareString (uint8_t x, uint8_t y, const char* text, uint8_t size)
+{
+    reference.gdl.useCustomFont = dev.gdl.useCustomFont;
+    reference.gdl.customFont = dev.gdl.customFont;
+
+    SSD1327ZB_drawString(&dev,x,y,text,SSD1327ZB_GRAYSCALE_12,SSD1327ZB_GRAYSCALE_3,size);
+    uint16_t xChar = x;
+    for (const char* c = text; *c != '\0'; ++c, xChar += 6*size)
+    {
+        if (GDL_drawChar(&reference.gdl,xChar,y,*c,SSD1327ZB_GRAYSCALE_12,
+                         SSD1327ZB_GRAYSCALE_3,size) != GDL_ERRORS_OK)
+            break;
+    }
+
+    uint32_t errors = 0;
+    for (uint16_t i = 0; i < sizeof(dev.buffer); ++i)
+    {
+        if (dev.buffer[i] != reference.buffer[i]) errors++;
+    }
+    if (errors != 0)
+        printf("string \"%s\" at (%u,%u): %u bytes differ\n",text,x,y,errors);
+    return errors;
+}
+
+/**
+ * @return The number of slots that hold a glyph.
+ */
+static uint8_t Test_usedSlots (void)
+{
+    uint8_t used = 0;
+    for (uint8_t i = 0; i < WARCOMEB_SSD1327ZB_GLYPH_SLOTS; ++i)
+    {
+        if (dev.glyph[i].width != 0) used++;
+    }
+    return used;
+}
+
+int main (void)
+{
+    memset(&reference,0,sizeof(reference));
+    Test_initDevice(&reference);
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+
+    // The same string twice: the second time every glyph is in the cache
+    TEST_CHECK(Test_compareString(1,2,"abab",1) == 0);
+    TEST_CHECK(Test_usedSlots() == 2);
+    uint16_t clock = dev.glyphClock;
+    TEST_CHECK(Test_compareString(1,2,"abab",1) == 0);
+    TEST_CHECK(Test_usedSlots() == 2);
+    TEST_CHECK((uint16_t)(dev.glyphClock - clock) == 4);
+
+    // More distinct chars than slots: the glyphs are evicted and rendered
+    // again, the string is still right
+    TEST_CHECK(Test_compareString(0,20,"ABCDEFGHIJKLMNOPQRST",1) == 0);
+    TEST_CHECK(Test_usedSlots() == WARCOMEB_SSD1327ZB_GLYPH_SLOTS);
+    TEST_CHECK(Test_compareString(3,40,"TSRQPONMLKJIHGFEDCBA",1) == 0);
+    TEST_CHECK(Test_compareString(0,60,"xyxyzwzwvuvu",2) == 0);
+
+    // Chars out of the display are clipped as GDL does
+    TEST_CHECK(Test_compareString(100,100,"clipped",1) == 0);
+
+    // A custom font and a change of the custom font
+    dev.gdl.useCustomFont = TRUE;
+    dev.gdl.customFont = &fontA;
+    TEST_CHECK(Test_compareString(1,80,"abab",1) == 0);
+    dev.gdl.customFont = &fontB;
+    TEST_CHECK(Test_compareString(1,90,"abab",1) == 0);
+    dev.gdl.useCustomFont = FALSE;
+    TEST_CHECK(Test_compareString(1,100,"abab",1) == 0);
+
+    // A single char
+    SSD1327ZB_drawChar(&dev,50,110,'q',SSD1327ZB_GRAYSCALE_12,SSD1327ZB_GRAYSCALE_3,1);
+    GDL_drawChar(&reference.gdl,50,110,'q',SSD1327ZB_GRAYSCALE_12,SSD1327ZB_GRAYSCALE_3,1);
+    TEST_CHECK(memcmp(dev.buffer,reference.buffer,sizeof(dev.buffer)) == 0);
+
+    return Test_end("glyph");
+}
@@ -0,0 +1,271 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Gray pictures: SSD1327ZB_drawGrayPicture must convert flat grays to the
+ * expected levels, and the ordered dither and the error diffusion, that
+ * keep the state of a single row, must give the same pixels of a reference
+ * that converts the whole picture at once, on odd columns, with odd widths
+ * and on the edges of the display. The test is built for the whole frame
+ * and for a buffer that holds a band.
+ */
+
+#include "test.h"
+
+#define TEST_WIDTH                               128
+#define TEST_HEIGHT                              128
+#define TEST_STRIDE                              (TEST_WIDTH/2)
+
+static SSD1327ZB_Device dev;
+static uint8_t reference [TEST_HEIGHT*TEST_STRIDE];
+static uint8_t picture [TEST_HEIGHT*TEST_WIDTH];
+static int16_t errors [TEST_HEIGHT+1][TEST_WIDTH+2];
+
+static const uint8_t Test_bayer[4][4] =
+{
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 },
+};
+
+static uint32_t Test_seed = 0x68E31DA4u;
+
+static uint32_t Test_random (uint32_t limit)
+{
+    Test_seed ^= Test_seed << 13;
+    Test_seed ^= Test_seed >> 17;
+    Test_seed ^= Test_seed << 5;
+    return Test_seed % limit;
+}
+
+static uint8_t Test_getPixel (const uint8_t* frame, uint8_t x, uint8_t y)
+{
+    uint8_t value = frame[(y * TEST_STRIDE) + (x/2)];
+    return (x%2) ? (value >> 4) : (value & 0x0F);
+}
+
+static void Test_setPixel (uint8_t* frame, uint8_t x, uint8_t y, uint8_t color)
+{
+    uint8_t* pixel = &frame[(y * TEST_STRIDE) + (x/2)];
+    if (x%2)
+        *pixel = (uint8_t)(color << 4) | (*pixel & 0x0F);
+    else
+        *pixel = (color & 0x0F) | (*pixel & 0xF0);
+}
+
+/**
+ * The function convert the whole picture into the reference. The error
+ * diffusion keeps the error of every pixel of the picture, and the error
+ * of the pixels out of the picture is dropped.
+ */
+static void Test_convert (uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                          SSD1327ZB_Dither dither)
+{
+    memset(errors,0,sizeof(errors));
+    for (uint16_t j = 0; j < height; ++j)
+    {
+        for (uint16_t i = 0; i < width; ++i)
+        {
+            int16_t value = picture[(j * width) + i];
+            uint8_t level;
+            switch (dither)
+            {
+            case SSD1327ZB_DITHER_NONE:
+                level = value >> 4;
+                break;
+            case SSD1327ZB_DITHER_ORDERED:
+                level = (value + Test_bayer[(y + j) % 4][(x + i) % 4] + 1) / 17;
+                break;
+            default:
+            {
+                value += errors[j][i + 1];
+                if (value < 0) value = 0;
+                if (value > 255) value = 255;
+                level = (value + 8) / 17;
+                int16_t error = value - (level * 17);
+                int16_t right = (error * 7) / 16;
+                int16_t left = (error * 3) / 16;
+                int16_t down = (error * 5) / 16;
+                errors[j][i + 2] += right;
+                errors[j + 1][i] += left;
+                errors[j + 1][i + 1] += down;
+                errors[j + 1][i + 2] += error - right - left - down;
+            }
+                break;
+            }
+            Test_setPixel(reference,x + i,y + j,level);
+        }
+    }
+}
+
+/**
+ * The function draw the picture in every band and return the number of
+ * bytes different from the reference.
+ */
+static uint32_t Test_compare (uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                              SSD1327ZB_Dither dither)
+{
+    uint32_t wrong = 0;
+
+    memset(reference,0x5A,sizeof(reference));
+    Test_convert(x,y,width,height,dither);
+
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    for (uint16_t band = 0; band < TEST_HEIGHT; band += dev.bandRows)
+    {
+        dev.bandStart = band;
+        uint16_t rows = dev.bandRows;
+        if ((band + rows) > TEST_HEIGHT) rows = TEST_HEIGHT - band;
+#else
+        const uint16_t band = 0;
+        const uint16_t rows = TEST_HEIGHT;
+#endif
+        memset(dev.buffer,0x5A,sizeof(dev.buffer));
+        TEST_CHECK(SSD1327ZB_drawGrayPicture(&dev,x,y,width,height,picture,dither) == GDL_ERRORS_OK);
+        for (uint16_t i = 0; i < (rows * TEST_STRIDE); ++i)
+        {
+            if (dev.buffer[i] != reference[(band * TEST_STRIDE) + i]) wrong++;
+        }
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    }
+#endif
+
+    if (wrong != 0)
+        printf("gray %u (%u,%u) %ux%u: %u bytes differ\n",dither,x,y,width,height,wrong);
+    return wrong;
+}
+
+/**
+ * @return The number of pixels of the area with a level out of the range.
+ */
+static uint32_t Test_countOut (uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                               uint8_t low, uint8_t high)
+{
+    uint32_t count = 0;
+    for (uint16_t j = y; j < (y + height); ++j)
+    {
+        for (uint16_t i = x; i < (x + width); ++i)
+        {
+            uint8_t level = Test_getPixel(reference,i,j);
+            if ((level < low) || (level > high)) count++;
+        }
+    }
+    return count;
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+
+    // Flat grays
+    for (uint16_t gray = 0; gray < 256; ++gray)
+    {
+        memset(picture,gray,sizeof(picture));
+        const uint8_t level = gray / 17;
+        const uint8_t rest = gray % 17;
+
+        // The 4 less significant bits are dropped
+        TEST_CHECK(Test_compare(0,0,TEST_WIDTH,TEST_HEIGHT,SSD1327ZB_DITHER_NONE) == 0);
+        TEST_CHECK(Test_countOut(0,0,TEST_WIDTH,TEST_HEIGHT,gray >> 4,gray >> 4) == 0);
+
+        // Every 4x4 tile has as many pixels of the upper level as the rest
+        TEST_CHECK(Test_compare(0,0,TEST_WIDTH,TEST_HEIGHT,SSD1327ZB_DITHER_ORDERED) == 0);
+        uint8_t upper = 0;
+        for (uint8_t j = 0; j < 4; ++j)
+        {
+            for (uint8_t i = 0; i < 4; ++i)
+            {
+                if (Test_getPixel(reference,i,j) > level) upper++;
+            }
+        }
+        TEST_CHECK(upper == rest);
+        TEST_CHECK(Test_countOut(0,0,TEST_WIDTH,TEST_HEIGHT,level,(rest != 0) ? level + 1 : level) == 0);
+
+        // The diffusion uses the two nearest levels with the same mean of
+        // the gray
+        TEST_CHECK(Test_compare(0,0,TEST_WIDTH,TEST_HEIGHT,SSD1327ZB_DITHER_DIFFUSION) == 0);
+        TEST_CHECK(Test_countOut(0,0,TEST_WIDTH,TEST_HEIGHT,level,(rest != 0) ? level + 1 : level) == 0);
+        uint32_t sum = 0;
+        for (uint16_t j = 32; j < 96; ++j)
+        {
+            for (uint16_t i = 32; i < 96; ++i)
+            {
+                sum += Test_getPixel(reference,i,j) * 17;
+            }
+        }
+        int32_t difference = (int32_t)((sum + (64*64)/2) / (64*64)) - gray;
+        TEST_CHECK((difference >= -1) && (difference <= 1));
+    }
+
+    // Random pictures on odd columns, with odd widths and on the edges
+    for (uint16_t i = 0; i < sizeof(picture); ++i)
+    {
+        picture[i] = (uint8_t) Test_random(256);
+    }
+    const uint8_t places [][4] =
+    {
+        {   0,   0, 128, 128 },
+        {   1,   0, 127, 128 },
+        {   1,   3,   7,   5 },
+        {   2,   3,   9,   5 },
+        { 117, 120,  11,   8 },
+        { 127, 127,   1,   1 },
+        {   0,  20,   1,  40 },
+        {  63,  21,  65,  31 },
+    };
+    for (uint8_t dither = SSD1327ZB_DITHER_NONE; dither <= SSD1327ZB_DITHER_DIFFUSION; ++dither)
+    {
+        for (uint8_t i = 0; i < sizeof(places)/sizeof(places[0]); ++i)
+        {
+            TEST_CHECK(Test_compare(places[i][0],places[i][1],places[i][2],places[i][3],dither) == 0);
+        }
+        for (uint16_t i = 0; i < 100; ++i)
+        {
+            uint8_t width = 1 + Test_random(TEST_WIDTH);
+            uint8_t height = 1 + Test_random(TEST_HEIGHT);
+            uint8_t x = Test_random(TEST_WIDTH - width + 1);
+            uint8_t y = Test_random(TEST_HEIGHT - height + 1);
+            TEST_CHECK(Test_compare(x,y,width,height,(SSD1327ZB_Dither) dither) == 0);
+        }
+    }
+
+    // Pictures that do not fit are refused and the buffer is untouched
+    memset(dev.buffer,0x5A,sizeof(dev.buffer));
+    TEST_CHECK(SSD1327ZB_drawGrayPicture(&dev,120,0,9,4,picture,SSD1327ZB_DITHER_DIFFUSION) == GDL_ERRORS_WRONG_POSITION);
+    TEST_CHECK(SSD1327ZB_drawGrayPicture(&dev,0,125,4,4,picture,SSD1327ZB_DITHER_ORDERED) == GDL_ERRORS_WRONG_POSITION);
+    TEST_CHECK(SSD1327ZB_drawGrayPicture(&dev,0,0,4,4,picture,(SSD1327ZB_Dither) 3) == GDL_ERRORS_WRONG_VALUE);
+    for (uint16_t i = 0; i < sizeof(dev.buffer); ++i)
+    {
+        TEST_CHECK(dev.buffer[i] == 0x5A);
+    }
+
+    return Test_end("gray");
+}
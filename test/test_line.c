@@ -0,0 +1,124 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+
+/*
+ * Lines: SSD1327ZB_drawLine must draw the same pixels of the per-pixel
+ * Bresenham of GDL, also when the line is partly out of the display. The
+ * test is built for the whole frame and for a buffer that holds a band.
+ */
+
+#include "test.h"
+
+static SSD1327ZB_Device dev;
+static SSD1327ZB_Device reference;
+
+static uint32_t Test_seed = 0x2545F491u;
+
+static uint8_t Test_random (void)
+{
+    Test_seed ^= Test_seed << 13;
+    Test_seed ^= Test_seed >> 17;
+    Test_seed ^= Test_seed << 5;
+    return (uint8_t) Test_seed;
+}
+
+/**
+ * The function draw a line with both devices in every band and return the
+ * number of different bytes.
+ */
+static uint32_t Test_compareLine (uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+    uint32_t errors = 0;
+
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    for (uint16_t band = 0; band < dev.gdl.height; band += dev.bandRows)
+    {
+        dev.bandStart = band;
+        reference.bandStart = band;
+#endif
+        memset(dev.buffer,0,sizeof(dev.buffer));
+        memset(reference.buffer,0,sizeof(reference.buffer));
+
+        SSD1327ZB_drawLine(&dev,x0,y0,x1,y1,SSD1327ZB_GRAYSCALE_9);
+        GDL_drawLine(&reference.gdl,x0,y0,x1,y1,SSD1327ZB_GRAYSCALE_9);
+
+        for (uint16_t i = 0; i < sizeof(dev.buffer); ++i)
+        {
+            if (dev.buffer[i] != reference.buffer[i]) errors++;
+        }
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    }
+#endif
+
+    if (errors != 0)
+        printf("line (%u,%u)-(%u,%u): %u bytes differ\n",x0,y0,x1,y1,errors);
+    return errors;
+}
+
+int main (void)
+{
+    memset(&reference,0,sizeof(reference));
+    Test_initDevice(&reference);
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+
+    // Lines that enter and leave the display
+    TEST_CHECK(Test_compareLine(17,10,217,204) == 0);
+    TEST_CHECK(Test_compareLine(217,204,17,10) == 0);
+    TEST_CHECK(Test_compareLine(200,3,5,250) == 0);
+    TEST_CHECK(Test_compareLine(0,127,255,128) == 0);
+    TEST_CHECK(Test_compareLine(127,0,128,255) == 0);
+    TEST_CHECK(Test_compareLine(255,0,0,255) == 0);
+    TEST_CHECK(Test_compareLine(130,200,140,250) == 0);
+
+    // Vertical lines down to the last row of the display and of the band
+    TEST_CHECK(Test_compareLine(127,0,127,127) == 0);
+    TEST_CHECK(Test_compareLine(0,255,0,100) == 0);
+    TEST_CHECK(Test_compareLine(33,23,33,47) == 0);
+
+    uint32_t lines = 0;
+    uint32_t wrongLines = 0;
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        uint8_t x0 = Test_random(), y0 = Test_random();
+        uint8_t x1 = Test_random(), y1 = Test_random();
+        // One line on four fully into the display
+        if ((i % 4) == 0)
+        {
+            x0 &= 0x7F; y0 &= 0x7F; x1 &= 0x7F; y1 &= 0x7F;
+        }
+        lines++;
+        if ((Test_compareLine(x0,y0,x1,y1) != 0) && (++wrongLines > 10)) break;
+    }
+    TEST_CHECK(wrongLines == 0);
+    printf("line: %u lines compared\n",lines);
+
+    return Test_end("line");
+}
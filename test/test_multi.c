@@ -0,0 +1,163 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+
+/*
+ * Displays of different sizes: the geometry, the offsets and the user
+ * buffer are checked by SSD1327ZB_init, a display smaller than the biggest
+ * one is drawn and flushed with its own size, and a group of two panels of
+ * different sizes on the same bus is flushed into the part of the display
+ * memory of every panel.
+ */
+
+#include "test.h"
+
+static SSD1327ZB_Device dev;
+static uint8_t frame [48*(64/2)];
+
+static SSD1327ZB_Device other;
+static uint8_t otherFrame [96*(96/2)];
+
+/**
+ * The function initialize a device with the selected size and buffer.
+ */
+static GDL_Errors Test_init (uint16_t width, uint16_t height, uint8_t* buffer, uint16_t size)
+{
+    memset(&dev,0,sizeof(dev));
+    dev.gdl.width = width;
+    dev.gdl.height = height;
+    dev.buffer = buffer;
+    dev.bufferSize = size;
+    return Test_initDevice(&dev);
+}
+
+int main (void)
+{
+    // Wrong geometry or buffer
+    TEST_CHECK(Test_init(64,48,frame,0) == GDL_ERRORS_WRONG_VALUE);
+    TEST_CHECK(Test_init(64,48,0,sizeof(frame)) == GDL_ERRORS_WRONG_VALUE);
+    TEST_CHECK(Test_init(64,48,frame,sizeof(frame) - 1) == GDL_ERRORS_WRONG_VALUE);
+    TEST_CHECK(Test_init(1,48,frame,sizeof(frame)) == GDL_ERRORS_WRONG_VALUE);
+    TEST_CHECK(Test_init(130,48,frame,sizeof(frame)) == GDL_ERRORS_WRONG_VALUE);
+    TEST_CHECK(Test_init(64,129,frame,sizeof(frame)) == GDL_ERRORS_WRONG_VALUE);
+    // The default size needs a bigger buffer
+    TEST_CHECK(Test_init(0,0,frame,sizeof(frame)) == GDL_ERRORS_WRONG_VALUE);
+
+    // An odd width is rounded down
+    TEST_CHECK(Test_init(65,48,frame,sizeof(frame)) == GDL_ERRORS_OK);
+    TEST_CHECK(dev.gdl.width == 64);
+    TEST_CHECK(dev.gdl.height == 48);
+
+    memset(frame,0,sizeof(frame));
+    SSD1327ZB_flush(&dev);
+    SSD1327ZB_drawRectangle(&dev,5,3,40,30,SSD1327ZB_GRAYSCALE_11,TRUE);
+    SSD1327ZB_drawLine(&dev,0,47,63,0,SSD1327ZB_GRAYSCALE_4);
+    // Out of the small display
+    SSD1327ZB_drawPixel(&dev,70,10,SSD1327ZB_GRAYSCALE_15);
+
+    SSD1327ZB_Device* group[] = {&dev};
+    SSD1327ZB_flushGroup(group,1);
+    TEST_CHECK(dev.dirtyCount == 0);
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+    TEST_CHECK(MockBus_getPixel(70,10) == 0);
+
+    // Offsets out of the display memory, an odd offset is rounded down
+    TEST_CHECK(Test_init(64,48,frame,sizeof(frame)) == GDL_ERRORS_OK);
+    dev.xOffset = 66;
+    dev.yOffset = 0;
+    TEST_CHECK(SSD1327ZB_init(&dev) == GDL_ERRORS_WRONG_VALUE);
+    dev.xOffset = 0;
+    dev.yOffset = 81;
+    TEST_CHECK(SSD1327ZB_init(&dev) == GDL_ERRORS_WRONG_VALUE);
+    dev.xOffset = 33;
+    dev.yOffset = 80;
+    TEST_CHECK(SSD1327ZB_init(&dev) == GDL_ERRORS_OK);
+    TEST_CHECK(dev.xOffset == 32);
+
+    // A second panel 96x96 in the middle of the display memory, with its
+    // own chip select on the same bus
+    memset(&other,0,sizeof(other));
+    other.gdl = dev.gdl;
+    other.gdl.cs = MOCKBUS_PIN_CS_OTHER;
+    other.gdl.width = 96;
+    other.gdl.height = 96;
+    other.buffer = otherFrame;
+    other.bufferSize = sizeof(otherFrame);
+    other.xOffset = 16;
+    other.yOffset = 16;
+    TEST_CHECK(SSD1327ZB_init(&other) == GDL_ERRORS_OK);
+
+    memset(frame,0,sizeof(frame));
+    memset(otherFrame,0,sizeof(otherFrame));
+    SSD1327ZB_flush(&dev);
+    SSD1327ZB_flush(&other);
+    SSD1327ZB_drawRectangle(&dev,0,0,64,48,SSD1327ZB_GRAYSCALE_6,FALSE);
+    SSD1327ZB_drawLine(&dev,1,1,62,46,SSD1327ZB_GRAYSCALE_13);
+    SSD1327ZB_drawRectangle(&other,0,0,96,96,SSD1327ZB_GRAYSCALE_9,FALSE);
+    SSD1327ZB_drawRectangle(&other,10,20,30,40,SSD1327ZB_GRAYSCALE_3,TRUE);
+    SSD1327ZB_drawPixel(&other,95,95,SSD1327ZB_GRAYSCALE_15);
+
+    MockBus_resetCounters();
+    SSD1327ZB_Device* pair[] = {&dev,&other};
+    SSD1327ZB_flushGroup(pair,2);
+    TEST_CHECK((dev.dirtyCount == 0) && (other.dirtyCount == 0));
+    TEST_CHECK(MockBus_counters.transactions == 2);
+    TEST_CHECK(MockBus_counters.errors == 0);
+
+    // Every panel shows its buffer into its part of the memory, the rest
+    // of the memory is untouched
+    uint32_t wrong = 0;
+    for (uint16_t y = 0; y < 128; ++y)
+    {
+        for (uint16_t x = 0; x < 128; ++x)
+        {
+            uint8_t expected = 0;
+            if ((x >= 32) && (x < 96) && (y >= 80))
+            {
+                uint8_t value = frame[((y - 80) * 32) + ((x - 32)/2)];
+                expected = (x%2) ? (value >> 4) : (value & 0x0F);
+            }
+            if (MockBus_getPixel(x,y) != expected) wrong++;
+
+            expected = 0;
+            if ((x >= 16) && (x < 112) && (y >= 16) && (y < 112))
+            {
+                uint8_t value = otherFrame[((y - 16) * 48) + ((x - 16)/2)];
+                expected = (x%2) ? (value >> 4) : (value & 0x0F);
+            }
+            uint8_t value = MockBus_otherPanel.gddram[y][x/2];
+            if (((x%2) ? (value >> 4) : (value & 0x0F)) != expected) wrong++;
+        }
+    }
+    TEST_CHECK(wrong == 0);
+    TEST_CHECK(MockBus_getPixel(32,80) == 6);
+    TEST_CHECK((MockBus_otherPanel.gddram[111][111/2] >> 4) == 15);
+
+    return Test_end("multi");
+}
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Pictures: the 1 bit and 4 bit pictures drawn by SSD1327ZB_drawPicture
+ * must have the same pixels of the per-pixel GDL path, on odd and even
+ * columns, with odd widths and on the edges of the display. The test is
+ * built for the whole frame and for a buffer that holds a band.
+ */
+
+#include "test.h"
+
+static SSD1327ZB_Device dev;
+static SSD1327ZB_Device reference;
+
+static uint8_t picture [128*128/2];
+
+static uint32_t Test_seed = 0x9E3779B9u;
+
+static uint32_t Test_random (uint32_t limit)
+{
+    Test_seed ^= Test_seed << 13;
+    Test_seed ^= Test_seed >> 17;
+    Test_seed ^= Test_seed << 5;
+    return Test_seed % limit;
+}
+
+/**
+ * The function draw the picture with both devices in every band and return
+ * the number of different bytes. The 1 bit pictures of the reference are
+ * drawn pixel by pixel with the chosen colors.
+ */
+static uint32_t Test_comparePicture (uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                                     GDL_PictureType type,
+                                     uint8_t foreground, uint8_t background)
+{
+    uint32_t errors = 0;
+
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    for (uint16_t band = 0; band < dev.gdl.height; band += dev.bandRows)
+    {
+        dev.bandStart = band;
+        reference.bandStart = band;
+#endif
+        memset(dev.buffer,0x5A,sizeof(dev.buffer));
+        memset(reference.buffer,0x5A,sizeof(reference.buffer));
+
+        SSD1327ZB_drawPicture(&dev,x,y,width,height,picture,type);
+        if (type == GDL_PICTURETYPE_4BIT)
+        {
+            GDL_drawPicture(&reference.gdl,x,y,width,height,picture,type);
+        }
+        else
+        {
+            for (uint16_t j = 0; j < height; ++j)
+            {
+                for (uint16_t i = 0; i < width; ++i)
+                {
+                    uint8_t value = picture[(j * ((width + 7)/8)) + (i/8)];
+                    SSD1327ZB_drawPixel(&reference,x+i,y+j,
+                                        (value & (0x80 >> (i%8))) ? foreground : background);
+                }
+            }
+        }
+
+        for (uint16_t i = 0; i < sizeof(dev.buffer); ++i)
+        {
+            if (dev.buffer[i] != reference.buffer[i]) errors++;
+        }
+#if defined WARCOMEB_SSD1327ZB_BANDED
+    }
+#endif
+
+    if (errors != 0)
+        printf("picture %u bit (%u,%u) %ux%u: %u bytes differ\n",type,x,y,width,height,errors);
+    return errors;
+}
+
+int main (void)
+{
+    memset(&reference,0,sizeof(reference));
+    Test_initDevice(&reference);
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+
+    for (uint16_t i = 0; i < sizeof(picture); ++i)
+    {
+        picture[i] = (uint8_t) Test_random(256);
+    }
+
+    const GDL_PictureType types [2] = {GDL_PICTURETYPE_4BIT, GDL_PICTURETYPE_1BIT};
+    for (uint8_t t = 0; t < 2; ++t)
+    {
+        // Odd and even columns, odd widths, on the edges of the display
+        TEST_CHECK(Test_comparePicture(0,0,128,128,types[t],15,0) == 0);
+        TEST_CHECK(Test_comparePicture(1,0,1,1,types[t],15,0) == 0);
+        TEST_CHECK(Test_comparePicture(1,3,7,5,types[t],15,0) == 0);
+        TEST_CHECK(Test_comparePicture(2,3,9,5,types[t],15,0) == 0);
+        TEST_CHECK(Test_comparePicture(117,120,11,8,types[t],15,0) == 0);
+        TEST_CHECK(Test_comparePicture(127,127,1,1,types[t],15,0) == 0);
+        TEST_CHECK(Test_comparePicture(0,10,127,3,types[t],15,0) == 0);
+        TEST_CHECK(Test_comparePicture(1,10,127,3,types[t],15,0) == 0);
+
+        for (uint16_t i = 0; i < 200; ++i)
+        {
+            uint8_t width = 1 + Test_random(128);
+            uint8_t height = 1 + Test_random(32);
+            uint8_t x = Test_random(128 - width + 1);
+            uint8_t y = Test_random(128 - height + 1);
+            TEST_CHECK(Test_comparePicture(x,y,width,height,types[t],15,0) == 0);
+        }
+
+        // Pictures that do not fit are refused and the buffer is untouched
+        memset(dev.buffer,0x5A,sizeof(dev.buffer));
+        TEST_CHECK(SSD1327ZB_drawPicture(&dev,120,0,9,4,picture,types[t]) == GDL_ERRORS_WRONG_POSITION);
+        TEST_CHECK(SSD1327ZB_drawPicture(&dev,0,125,4,4,picture,types[t]) == GDL_ERRORS_WRONG_POSITION);
+        for (uint16_t i = 0; i < sizeof(dev.buffer); ++i)
+        {
+            TEST_CHECK(dev.buffer[i] == 0x5A);
+        }
+    }
+
+    // The colors of the 1 bit pictures
+    SSD1327ZB_setPictureColors(&dev,SSD1327ZB_GRAYSCALE_9,SSD1327ZB_GRAYSCALE_2);
+    TEST_CHECK(Test_comparePicture(3,5,21,7,GDL_PICTURETYPE_1BIT,9,2) == 0);
+    TEST_CHECK(Test_comparePicture(0,0,128,128,GDL_PICTURETYPE_1BIT,9,2) == 0);
+    SSD1327ZB_setPictureColors(&dev,SSD1327ZB_GRAYSCALE_0,SSD1327ZB_GRAYSCALE_15);
+    TEST_CHECK(Test_comparePicture(77,1,13,30,GDL_PICTURETYPE_1BIT,0,15) == 0);
+
+    TEST_CHECK(SSD1327ZB_drawPicture(&dev,0,0,8,8,picture,(GDL_PictureType) 2) == GDL_ERRORS_WRONG_VALUE);
+
+    return Test_end("picture");
+}
@@ -0,0 +1,177 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Spans and points: SSD1327ZB_drawSpan and SSD1327ZB_drawPoints must write
+ * the same pixels of a per-pixel reference, and a scattered list of points
+ * must be marked dirty as small areas, not as the box that holds the list.
+ */
+
+#include "test.h"
+
+#define TEST_WIDTH                               128
+#define TEST_HEIGHT                              128
+#define TEST_STRIDE                              (TEST_WIDTH/2)
+
+static SSD1327ZB_Device dev;
+static uint8_t reference [TEST_HEIGHT*TEST_STRIDE];
+
+static uint32_t Test_seed = 0x68E31DA4u;
+
+static uint32_t Test_random (uint32_t limit)
+{
+    Test_seed ^= Test_seed << 13;
+    Test_seed ^= Test_seed >> 17;
+    Test_seed ^= Test_seed << 5;
+    return Test_seed % limit;
+}
+
+static void Test_setPixel (uint8_t* frame, uint8_t x, uint8_t y, uint8_t color)
+{
+    uint8_t* pixel = &frame[(y * TEST_STRIDE) + (x/2)];
+    if (x%2)
+        *pixel = (uint8_t)(color << 4) | (*pixel & 0x0F);
+    else
+        *pixel = (color & 0x0F) | (*pixel & 0xF0);
+}
+
+static uint32_t Test_compare (void)
+{
+    uint32_t errors = 0;
+    for (uint16_t i = 0; i < sizeof(reference); ++i)
+    {
+        if (dev.buffer[i] != reference[i]) errors++;
+    }
+    return errors;
+}
+
+/**
+ * The function draw a span with the device and the reference, and return
+ * the number of different bytes.
+ */
+static uint32_t Test_span (uint8_t x, uint8_t y, uint16_t length)
+{
+    uint8_t colors [TEST_WIDTH + 8];
+    for (uint16_t i = 0; i < length; ++i)
+    {
+        colors[i] = (uint8_t) Test_random(16);
+        if ((x + i) < TEST_WIDTH) Test_setPixel(reference,x+i,y,colors[i]);
+    }
+    SSD1327ZB_drawSpan(&dev,x,y,length,colors);
+
+    uint32_t errors = Test_compare();
+    if (errors != 0)
+        printf("span (%u,%u) length %u: %u bytes differ\n",x,y,length,errors);
+    return errors;
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+    memset(reference,0,sizeof(reference));
+
+    // Spans on even and odd columns, with even and odd lengths
+    TEST_CHECK(Test_span(0,0,TEST_WIDTH) == 0);
+    TEST_CHECK(Test_span(1,1,1) == 0);
+    TEST_CHECK(Test_span(1,2,2) == 0);
+    TEST_CHECK(Test_span(2,3,7) == 0);
+    TEST_CHECK(Test_span(5,4,30) == 0);
+    // Clipped at the right edge
+    TEST_CHECK(Test_span(121,5,20) == 0);
+    TEST_CHECK(Test_span(127,6,3) == 0);
+    for (uint16_t i = 0; i < 500; ++i)
+    {
+        TEST_CHECK(Test_span(Test_random(TEST_WIDTH),Test_random(TEST_HEIGHT),
+                             1 + Test_random(TEST_WIDTH + 8)) == 0);
+    }
+    // Out of the display
+    uint8_t color = 5;
+    TEST_CHECK(SSD1327ZB_drawSpan(&dev,TEST_WIDTH,0,1,&color) == GDL_ERRORS_WRONG_POSITION);
+    TEST_CHECK(Test_compare() == 0);
+
+    // A list of points, some of them out of the display
+    SSD1327ZB_Point points [400];
+    for (uint16_t i = 0; i < 400; ++i)
+    {
+        points[i].xPos = (uint8_t) Test_random(TEST_WIDTH + 16);
+        points[i].yPos = (uint8_t) Test_random(TEST_HEIGHT + 16);
+        points[i].color = (uint8_t) Test_random(16);
+        if ((points[i].xPos < TEST_WIDTH) && (points[i].yPos < TEST_HEIGHT))
+            Test_setPixel(reference,points[i].xPos,points[i].yPos,points[i].color);
+    }
+    SSD1327ZB_drawPoints(&dev,points,400);
+    TEST_CHECK(Test_compare() == 0);
+
+    // Scattered points are marked as small areas
+    dev.dirtyCount = 0;
+    const SSD1327ZB_Point corners [] =
+    {
+        {2, 3, 15},
+        {120, 4, 15},
+        {6, 118, 15},
+        {117, 121, 15},
+    };
+    SSD1327ZB_drawPoints(&dev,corners,4);
+    TEST_CHECK(dev.dirtyCount == 4);
+    for (uint8_t i = 0; i < dev.dirtyCount; ++i)
+    {
+        TEST_CHECK(dev.dirty[i].yStart == dev.dirty[i].yStop);
+        TEST_CHECK((dev.dirty[i].xStop - dev.dirty[i].xStart) == 1);
+    }
+
+    // Near points of the same rows are merged into one area
+    dev.dirtyCount = 0;
+    const SSD1327ZB_Point cluster [] =
+    {
+        {40, 50, 1}, {44, 50, 2}, {41, 51, 3}, {47, 52, 4}, {42, 52, 5},
+    };
+    SSD1327ZB_drawPoints(&dev,cluster,5);
+    TEST_CHECK(dev.dirtyCount == 1);
+    TEST_CHECK((dev.dirty[0].xStart == 40) && (dev.dirty[0].xStop == 47));
+    TEST_CHECK((dev.dirty[0].yStart == 50) && (dev.dirty[0].yStop == 52));
+
+    // The flush of the dirty areas bring the panel to the buffer
+    SSD1327ZB_flush(&dev);
+    SSD1327ZB_Point moved [4];
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        moved[i] = corners[i];
+        moved[i].color = i;
+    }
+    dev.dirtyCount = 0;
+    SSD1327ZB_drawPoints(&dev,moved,4);
+    MockBus_resetCounters();
+    SSD1327ZB_flushDirty(&dev);
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+    // Four windows of one byte, not the whole display
+    TEST_CHECK(MockBus_panel.counters.dataBytes == 4);
+
+    return Test_end("points");
+}
@@ -0,0 +1,219 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+
+/*
+ * Raster operations: the word-wide SSD1327ZB_rasterOp, SSD1327ZB_rasterMask
+ * and SSD1327ZB_remapArea must give the same pixels of a per-pixel
+ * reference, for every operation and for areas that start or stop on odd
+ * columns and inside a word.
+ */
+
+#include "test.h"
+
+#define TEST_WIDTH                               128
+#define TEST_HEIGHT                              128
+#define TEST_STRIDE                              (TEST_WIDTH/2)
+
+static SSD1327ZB_Device dev;
+static uint8_t reference [TEST_HEIGHT*TEST_STRIDE];
+static uint8_t mask [TEST_HEIGHT*TEST_STRIDE];
+
+static uint32_t Test_seed = 0xB5297A4Du;
+
+static uint32_t Test_random (uint32_t limit)
+{
+    Test_seed ^= Test_seed << 13;
+    Test_seed ^= Test_seed >> 17;
+    Test_seed ^= Test_seed << 5;
+    return Test_seed % limit;
+}
+
+static uint8_t Test_getPixel (const uint8_t* frame, uint8_t x, uint8_t y)
+{
+    uint8_t value = frame[(y * TEST_STRIDE) + (x/2)];
+    return (x%2) ? (value >> 4) : (value & 0x0F);
+}
+
+static void Test_setPixel (uint8_t* frame, uint8_t x, uint8_t y, uint8_t color)
+{
+    uint8_t* pixel = &frame[(y * TEST_STRIDE) + (x/2)];
+    if (x%2)
+        *pixel = (uint8_t)(color << 4) | (*pixel & 0x0F);
+    else
+        *pixel = (color & 0x0F) | (*pixel & 0xF0);
+}
+
+static uint8_t Test_apply (SSD1327ZB_RasterOp op, uint8_t pixel, uint8_t operand)
+{
+    switch (op)
+    {
+    case SSD1327ZB_RASTEROP_INVERT:    return 15 - pixel;
+    case SSD1327ZB_RASTEROP_AND:       return pixel & operand;
+    case SSD1327ZB_RASTEROP_OR:        return pixel | operand;
+    case SSD1327ZB_RASTEROP_XOR:       return pixel ^ operand;
+    case SSD1327ZB_RASTEROP_DIM:       return (pixel > operand) ? (pixel - operand) : 0;
+    case SSD1327ZB_RASTEROP_BRIGHTEN:  return ((pixel + operand) > 15) ? 15 : (pixel + operand);
+    case SSD1327ZB_RASTEROP_THRESHOLD: return (pixel >= operand) ? 15 : 0;
+    }
+    return pixel;
+}
+
+/**
+ * The function fill the buffer and the reference with the same pixels.
+ */
+static void Test_fill (void)
+{
+    for (uint16_t i = 0; i < sizeof(reference); ++i)
+    {
+        reference[i] = (uint8_t) Test_random(256);
+    }
+    memcpy(dev.buffer,reference,sizeof(reference));
+}
+
+/**
+ * The function pick a rectangle, most of the times with odd edges.
+ */
+static void Test_area (uint8_t* x, uint8_t* y, uint8_t* width, uint8_t* height)
+{
+    switch (Test_random(4))
+    {
+    case 0:
+        // Inside a single word
+        *width = 1 + Test_random(7);
+        break;
+    case 1:
+        // The whole row
+        *x = 0;
+        *width = TEST_WIDTH;
+        break;
+    default:
+        *width = 1 + Test_random(TEST_WIDTH);
+        break;
+    }
+    if (*width != TEST_WIDTH) *x = Test_random(TEST_WIDTH - *width + 1);
+    *height = 1 + Test_random(8);
+    *y = Test_random(TEST_HEIGHT - *height + 1);
+}
+
+static uint32_t Test_compare (const char* name, SSD1327ZB_RasterOp op,
+                              uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    uint32_t errors = 0;
+    for (uint16_t i = 0; i < sizeof(reference); ++i)
+    {
+        if (dev.buffer[i] != reference[i]) errors++;
+    }
+    if (errors != 0)
+        printf("%s %d at (%u,%u) %ux%u: %u bytes differ\n",name,op,x,y,width,height,errors);
+    return errors;
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+
+    uint32_t wrong = 0;
+    for (uint8_t op = SSD1327ZB_RASTEROP_INVERT; op <= SSD1327ZB_RASTEROP_THRESHOLD; ++op)
+    {
+        for (uint16_t i = 0; i < 2000; ++i)
+        {
+            uint8_t x = 0, y, width, height;
+            Test_area(&x,&y,&width,&height);
+
+            // The same operand for every pixel
+            uint8_t value = Test_random(16);
+            Test_fill();
+            TEST_CHECK(SSD1327ZB_rasterOp(&dev,x,y,width,height,op,value) == GDL_ERRORS_OK);
+            for (uint8_t yy = y; yy < (y + height); ++yy)
+            {
+                for (uint16_t xx = x; xx < (x + width); ++xx)
+                {
+                    Test_setPixel(reference,xx,yy,Test_apply(op,Test_getPixel(reference,xx,yy),value));
+                }
+            }
+            if (Test_compare("rasterOp",op,x,y,width,height) != 0) wrong++;
+
+            // The operand of every pixel from the mask
+            for (uint16_t j = 0; j < sizeof(mask); ++j)
+            {
+                mask[j] = (uint8_t) Test_random(256);
+            }
+            Test_fill();
+            TEST_CHECK(SSD1327ZB_rasterMask(&dev,x,y,width,height,op,mask) == GDL_ERRORS_OK);
+            for (uint8_t yy = y; yy < (y + height); ++yy)
+            {
+                for (uint16_t xx = x; xx < (x + width); ++xx)
+                {
+                    Test_setPixel(reference,xx,yy,Test_apply(op,Test_getPixel(reference,xx,yy),
+                                                             Test_getPixel(mask,xx,yy)));
+                }
+            }
+            if (Test_compare("rasterMask",op,x,y,width,height) != 0) wrong++;
+
+            if (wrong > 10) break;
+        }
+    }
+    TEST_CHECK(wrong == 0);
+
+    // A table of levels
+    wrong = 0;
+    for (uint16_t i = 0; i < 2000; ++i)
+    {
+        uint8_t x = 0, y, width, height;
+        uint8_t table[16];
+        Test_area(&x,&y,&width,&height);
+        for (uint8_t j = 0; j < 16; ++j)
+        {
+            table[j] = Test_random(16);
+        }
+
+        Test_fill();
+        TEST_CHECK(SSD1327ZB_remapArea(&dev,x,y,width,height,table) == GDL_ERRORS_OK);
+        for (uint8_t yy = y; yy < (y + height); ++yy)
+        {
+            for (uint16_t xx = x; xx < (x + width); ++xx)
+            {
+                Test_setPixel(reference,xx,yy,table[Test_getPixel(reference,xx,yy)]);
+            }
+        }
+        if ((Test_compare("remapArea",0,x,y,width,height) != 0) && (++wrong > 10)) break;
+    }
+    TEST_CHECK(wrong == 0);
+
+    // Wrong arguments leave the buffer untouched
+    Test_fill();
+    TEST_CHECK(SSD1327ZB_rasterOp(&dev,0,0,8,8,(SSD1327ZB_RasterOp) 7,0) == GDL_ERRORS_WRONG_VALUE);
+    TEST_CHECK(SSD1327ZB_rasterOp(&dev,121,0,8,8,SSD1327ZB_RASTEROP_INVERT,0) == GDL_ERRORS_WRONG_POSITION);
+    TEST_CHECK(SSD1327ZB_rasterMask(&dev,0,121,8,8,SSD1327ZB_RASTEROP_AND,mask) == GDL_ERRORS_WRONG_POSITION);
+    TEST_CHECK(memcmp(dev.buffer,reference,sizeof(reference)) == 0);
+
+    return Test_end("raster");
+}
@@ -0,0 +1,182 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Compressed pictures: the pictures of rle_pictures.h, made by
+ * tools/ssd1327zb_rle.py from the PGM files of this folder, must give the
+ * pixels of the PGM files when they are decoded into the buffer and when
+ * they are sent straight to the panel. To make them again:
+ *     make fixtures
+ */
+
+#include "test.h"
+#include "rle_pictures.h"
+
+#define TEST_WIDTH                               128
+#define TEST_HEIGHT                              128
+#define TEST_STRIDE                              (TEST_WIDTH/2)
+
+static SSD1327ZB_Device dev;
+static uint8_t reference [TEST_HEIGHT*TEST_STRIDE];
+
+static uint8_t card [RLE_CARD_WIDTH*RLE_CARD_HEIGHT];
+static uint8_t splash [RLE_SPLASH_WIDTH*RLE_SPLASH_HEIGHT];
+
+/**
+ * The function read the gray levels of a P2 file with a single comment
+ * line and 15 as maximum value.
+ */
+static bool Test_readPgm (const char* path, uint8_t* pixels, uint16_t width, uint16_t height)
+{
+    FILE* file = fopen(path,"r");
+    if (file == 0) return FALSE;
+
+    unsigned int fileWidth, fileHeight, maxValue;
+    bool isRead = (fscanf(file,"P2 #%*[^\n] %u %u %u",&fileWidth,&fileHeight,&maxValue) == 3) &&
+                  (fileWidth == width) && (fileHeight == height) && (maxValue == 15);
+
+    for (uint32_t i = 0; isRead && (i < ((uint32_t) width * height)); ++i)
+    {
+        unsigned int value;
+        isRead = (fscanf(file,"%u",&value) == 1) && (value <= 15);
+        pixels[i] = (uint8_t) value;
+    }
+    fclose(file);
+    return isRead;
+}
+
+static void Test_setPixel (uint8_t* frame, uint8_t x, uint8_t y, uint8_t color)
+{
+    uint8_t* pixel = &frame[(y * TEST_STRIDE) + (x/2)];
+    if (x%2)
+        *pixel = (uint8_t)(color << 4) | (*pixel & 0x0F);
+    else
+        *pixel = (color & 0x0F) | (*pixel & 0xF0);
+}
+
+/**
+ * The function decode a picture into the buffer and return the number of
+ * bytes different from the reference.
+ */
+static uint32_t Test_draw (const uint8_t* data, const uint8_t* pixels,
+                           uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    memset(dev.buffer,0xA5,sizeof(dev.buffer));
+    memset(reference,0xA5,sizeof(reference));
+
+    TEST_CHECK(SSD1327ZB_drawCompressedPicture(&dev,x,y,width,height,data) == GDL_ERRORS_OK);
+    for (uint16_t j = 0; j < height; ++j)
+    {
+        for (uint16_t i = 0; i < width; ++i)
+        {
+            Test_setPixel(reference,x+i,y+j,pixels[(j * width) + i]);
+        }
+    }
+
+    uint32_t errors = 0;
+    for (uint16_t i = 0; i < sizeof(reference); ++i)
+    {
+        if (dev.buffer[i] != reference[i]) errors++;
+    }
+    if (errors != 0)
+        printf("draw %ux%u at (%u,%u): %u bytes differ\n",width,height,x,y,errors);
+    return errors;
+}
+
+/**
+ * The function send a picture straight to the panel and return the number
+ * of pixels of the panel different from the picture. The buffer must not
+ * change.
+ */
+static uint32_t Test_send (const uint8_t* data, const uint8_t* pixels,
+                           uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    memset(dev.buffer,0x33,sizeof(dev.buffer));
+    SSD1327ZB_flush(&dev);
+
+    MockBus_resetCounters();
+    TEST_CHECK(SSD1327ZB_sendCompressedPicture(&dev,x,y,width,height,data) == GDL_ERRORS_OK);
+    TEST_CHECK(MockBus_counters.dataBytes == ((uint32_t)(width/2) * height));
+    TEST_CHECK(MockBus_counters.transactions == 1);
+
+    uint32_t errors = 0;
+    for (uint16_t j = 0; j < TEST_HEIGHT; ++j)
+    {
+        for (uint16_t i = 0; i < TEST_WIDTH; ++i)
+        {
+            bool isInside = (i >= x) && (i < (x + width)) && (j >= y) && (j < (y + height));
+            uint8_t value = (isInside) ? pixels[((j - y) * width) + (i - x)] : 3;
+            if (Test_getPanelPixel(i,j) != value) errors++;
+        }
+    }
+    for (uint16_t i = 0; i < sizeof(dev.buffer); ++i)
+    {
+        if (dev.buffer[i] != 0x33) errors++;
+    }
+    if (errors != 0)
+        printf("send %ux%u at (%u,%u): %u pixels differ\n",width,height,x,y,errors);
+    return errors;
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+
+    TEST_CHECK(Test_readPgm("rle_card.pgm",card,RLE_CARD_WIDTH,RLE_CARD_HEIGHT));
+    TEST_CHECK(Test_readPgm("rle_splash.pgm",splash,RLE_SPLASH_WIDTH,RLE_SPLASH_HEIGHT));
+
+    // Odd width: the packets continue on the next row on both nibbles
+    TEST_CHECK(Test_draw(rle_card,card,0,0,RLE_CARD_WIDTH,RLE_CARD_HEIGHT) == 0);
+    TEST_CHECK(Test_draw(rle_card,card,1,7,RLE_CARD_WIDTH,RLE_CARD_HEIGHT) == 0);
+    TEST_CHECK(Test_draw(rle_card,card,90,100,RLE_CARD_WIDTH,RLE_CARD_HEIGHT) == 0);
+    TEST_CHECK(Test_draw(rle_card,card,91,105,RLE_CARD_WIDTH,RLE_CARD_HEIGHT) == 0);
+    // Long runs over several rows and literals longer than a packet
+    TEST_CHECK(Test_draw(rle_splash,splash,0,0,RLE_SPLASH_WIDTH,RLE_SPLASH_HEIGHT) == 0);
+    TEST_CHECK(Test_draw(rle_splash,splash,0,88,RLE_SPLASH_WIDTH,RLE_SPLASH_HEIGHT) == 0);
+
+    // Straight to the panel
+    TEST_CHECK(Test_send(rle_splash,splash,0,0,RLE_SPLASH_WIDTH,RLE_SPLASH_HEIGHT) == 0);
+    TEST_CHECK(Test_send(rle_splash,splash,0,51,RLE_SPLASH_WIDTH,RLE_SPLASH_HEIGHT) == 0);
+    TEST_CHECK(Test_send(rle_splash,splash,0,88,RLE_SPLASH_WIDTH,RLE_SPLASH_HEIGHT) == 0);
+
+    // The next flush sends the buffer again
+    SSD1327ZB_flush(&dev);
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    // Pictures out of the display or not aligned to the column pairs
+    TEST_CHECK(SSD1327ZB_drawCompressedPicture(&dev,92,0,RLE_CARD_WIDTH,RLE_CARD_HEIGHT,rle_card) ==
+               GDL_ERRORS_WRONG_POSITION);
+    TEST_CHECK(SSD1327ZB_sendCompressedPicture(&dev,0,89,RLE_SPLASH_WIDTH,RLE_SPLASH_HEIGHT,rle_splash) ==
+               GDL_ERRORS_WRONG_POSITION);
+    TEST_CHECK(SSD1327ZB_sendCompressedPicture(&dev,2,0,RLE_CARD_WIDTH,RLE_CARD_HEIGHT,rle_card) ==
+               GDL_ERRORS_WRONG_POSITION);
+
+    return Test_end("rle");
+}
@@ -0,0 +1,214 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Scroll: after SSD1327ZB_scroll by any offset, also around the end of the
+ * ring of rows, and after drawings across the seam of the ring, the flush
+ * of the dirty areas must bring the panel to the logical image. The test
+ * is built with and without the shadow memory.
+ */
+
+#include "test.h"
+
+#define TEST_WIDTH                               128
+#define TEST_HEIGHT                              128
+#define TEST_STRIDE                              (TEST_WIDTH/2)
+
+static SSD1327ZB_Device dev;
+/** The logical image, row 0 is the top row of the display */
+static uint8_t image [TEST_HEIGHT*TEST_STRIDE];
+
+static uint32_t Test_seed = 0x7F4A7C15u;
+
+static uint32_t Test_random (uint32_t limit)
+{
+    Test_seed ^= Test_seed << 13;
+    Test_seed ^= Test_seed >> 17;
+    Test_seed ^= Test_seed << 5;
+    return Test_seed % limit;
+}
+
+static uint8_t Test_getPixel (uint8_t x, uint8_t y)
+{
+    uint8_t value = image[(y * TEST_STRIDE) + (x/2)];
+    return (x%2) ? (value >> 4) : (value & 0x0F);
+}
+
+static void Test_setPixel (uint8_t x, uint8_t y, uint8_t color)
+{
+    uint8_t* pixel = &image[(y * TEST_STRIDE) + (x/2)];
+    if (x%2)
+        *pixel = (uint8_t)(color << 4) | (*pixel & 0x0F);
+    else
+        *pixel = (color & 0x0F) | (*pixel & 0xF0);
+}
+
+static void Test_fillImage (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color)
+{
+    for (uint16_t j = y; j < (y + height); ++j)
+    {
+        for (uint16_t i = x; i < (x + width); ++i)
+        {
+            Test_setPixel(i,j,color);
+        }
+    }
+}
+
+/**
+ * The function move the logical image as SSD1327ZB_scroll does.
+ */
+static void Test_scrollImage (int16_t lines, uint8_t background)
+{
+    uint8_t old [sizeof(image)];
+    memcpy(old,image,sizeof(image));
+
+    for (int16_t y = 0; y < TEST_HEIGHT; ++y)
+    {
+        int16_t from = y + lines;
+        if ((from < 0) || (from >= TEST_HEIGHT))
+            memset(&image[y * TEST_STRIDE],background * 0x11,TEST_STRIDE);
+        else
+            memcpy(&image[y * TEST_STRIDE],&old[from * TEST_STRIDE],TEST_STRIDE);
+    }
+}
+
+/**
+ * The function flush the dirty areas and return the number of pixels
+ * shown by the panel different from the logical image.
+ */
+static uint32_t Test_flushAndCompare (const char* step)
+{
+#if defined WARCOMEB_SSD1327ZB_SHADOW
+    dev.dirtyCount = 0;
+    SSD1327ZB_flushDiff(&dev);
+#else
+    SSD1327ZB_flushDirty(&dev);
+#endif
+
+    uint32_t errors = 0;
+    for (uint8_t y = 0; y < TEST_HEIGHT; ++y)
+    {
+        for (uint8_t x = 0; x < TEST_WIDTH; ++x)
+        {
+            if (Test_getPanelPixel(x,y) != Test_getPixel(x,y)) errors++;
+        }
+    }
+    if (errors != 0)
+        printf("%s (offset %u): %u pixels differ\n",step,dev.scrollOffset,errors);
+    // The buffer holds the same image of the panel
+    if (Test_comparePanel(&dev) != 0)
+    {
+        printf("%s (offset %u): the buffer differs from the panel\n",step,dev.scrollOffset);
+        errors++;
+    }
+    return errors;
+}
+
+/**
+ * The function draw some shapes with the device and into the image, the
+ * first of them on the rows given.
+ */
+static void Test_draw (uint8_t yStart, uint8_t yStop)
+{
+    uint8_t color = 1 + Test_random(15);
+    uint8_t x = Test_random(100);
+    SSD1327ZB_drawRectangle(&dev,x,yStart,21,yStop-yStart+1,(SSD1327ZB_GrayScale) color,TRUE);
+    Test_fillImage(x,yStart,21,yStop-yStart+1,color);
+
+    color = Test_random(16);
+    x = Test_random(TEST_WIDTH);
+    SSD1327ZB_drawVLine(&dev,x,0,TEST_HEIGHT-1,(SSD1327ZB_GrayScale) color);
+    Test_fillImage(x,0,1,TEST_HEIGHT,color);
+
+    color = Test_random(16);
+    uint8_t y = Test_random(TEST_HEIGHT);
+    SSD1327ZB_drawHLine(&dev,3,y,100,(SSD1327ZB_GrayScale) color);
+    Test_fillImage(3,y,101,1,color);
+
+    for (uint8_t i = 0; i < 20; ++i)
+    {
+        x = Test_random(TEST_WIDTH);
+        y = Test_random(TEST_HEIGHT);
+        color = Test_random(16);
+        SSD1327ZB_drawPixel(&dev,x,y,(SSD1327ZB_GrayScale) color);
+        Test_setPixel(x,y,color);
+    }
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+
+    memset(image,0,sizeof(image));
+    SSD1327ZB_clear(&dev);
+    SSD1327ZB_flush(&dev);
+    Test_draw(10,30);
+    TEST_CHECK(Test_flushAndCompare("first image") == 0);
+
+    // Offsets that move the ring around its end, in both directions
+    const int16_t offsets [] = {5, 37, -12, 100, -127, 64, 1, -1, 127, -60, 90};
+    for (uint8_t i = 0; i < (sizeof(offsets)/sizeof(offsets[0])); ++i)
+    {
+        uint8_t background = Test_random(16);
+        SSD1327ZB_scroll(&dev,offsets[i],(SSD1327ZB_GrayScale) background);
+        Test_scrollImage(offsets[i],background);
+        TEST_CHECK(MockBus_panel.startLine == dev.scrollOffset);
+        TEST_CHECK(Test_flushAndCompare("scroll") == 0);
+
+        // A drawing across the seam of the ring: the rows of the display
+        // that are at the end and at the start of the buffer
+        uint8_t seam = (TEST_HEIGHT - dev.scrollOffset) % TEST_HEIGHT;
+        uint8_t yStart = (seam > 8) ? (seam - 8) : 0;
+        uint8_t yStop = ((seam + 8) < TEST_HEIGHT) ? (seam + 8) : (TEST_HEIGHT - 1);
+        Test_draw(yStart,yStop);
+        TEST_CHECK(Test_flushAndCompare("seam") == 0);
+    }
+
+    // Drawings pending while the display scrolls move with the content
+    Test_draw(40,60);
+    SSD1327ZB_scroll(&dev,13,SSD1327ZB_GRAYSCALE_4);
+    Test_scrollImage(13,4);
+    Test_draw(0,5);
+    SSD1327ZB_scroll(&dev,-7,SSD1327ZB_GRAYSCALE_9);
+    Test_scrollImage(-7,9);
+    TEST_CHECK(Test_flushAndCompare("pending") == 0);
+
+    // A scroll of the whole display
+    SSD1327ZB_scroll(&dev,TEST_HEIGHT,SSD1327ZB_GRAYSCALE_6);
+    Test_scrollImage(TEST_HEIGHT,6);
+    TEST_CHECK(Test_flushAndCompare("whole") == 0);
+
+    // The full flush sends the ring as it is into the panel memory
+    Test_draw(100,127);
+    SSD1327ZB_flush(&dev);
+    TEST_CHECK(Test_flushAndCompare("full flush") == 0);
+
+    return Test_end("scroll");
+}
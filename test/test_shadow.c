@@ -0,0 +1,74 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+
+/*
+ * Shadow memory: SSD1327ZB_flushDiff must send the whole frame when the
+ * content of the display is unknown, also after a reset of a device that
+ * was already running or after a horizontal scroll.
+ */
+
+#include "test.h"
+
+static SSD1327ZB_Device dev;
+
+int main (void)
+{
+    // Garbage into the device, as a not initialized static of a board
+    memset(&dev,0xA5,sizeof(dev));
+    Test_initDevice(&dev);
+
+    for (uint16_t i = 0; i < WARCOMEB_SSD1327ZB_BUFFERDIMENSION; ++i)
+    {
+        dev.buffer[i] = (uint8_t)(i * 7);
+    }
+    SSD1327ZB_flushDiff(&dev);
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    // Nothing changed: nothing to send
+    MockBus_resetCounters();
+    SSD1327ZB_flushDiff(&dev);
+    TEST_CHECK(MockBus_panel.counters.dataBytes == 0);
+
+    // The panel is reset and the device initialized again, the buffer
+    // keeps the old frame
+    Test_initDevice(&dev);
+    TEST_CHECK(Test_comparePanel(&dev) != 0);
+    SSD1327ZB_flushDiff(&dev);
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    // The scroll moves the display memory
+    SSD1327ZB_startHorizontalScroll(&dev,SSD1327ZB_SCROLLDIRECTION_RIGHT,0,127,0,63,0);
+    SSD1327ZB_stopHorizontalScroll(&dev);
+    MockBus_resetCounters();
+    SSD1327ZB_flushDiff(&dev);
+    TEST_CHECK(MockBus_panel.counters.dataBytes == WARCOMEB_SSD1327ZB_BUFFERDIMENSION);
+
+    return Test_end("shadow");
+}
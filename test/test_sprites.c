@@ -0,0 +1,265 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Sprites: the buffer composed by the sprite functions must have the same
+ * pixels of a per-pixel composition of the background and the visible
+ * sprites, every changed pixel must be into the dirty areas, and a move
+ * must mark only the old and the new area of the sprite.
+ */
+
+#include "test.h"
+
+#define TEST_WIDTH                               128
+#define TEST_HEIGHT                              128
+#define TEST_STRIDE                              (TEST_WIDTH/2)
+
+static SSD1327ZB_Device dev;
+static uint8_t background [TEST_HEIGHT*TEST_STRIDE];
+static uint8_t reference [TEST_HEIGHT*TEST_STRIDE];
+static uint8_t before [TEST_HEIGHT*TEST_STRIDE];
+
+/** Odd width, transparent color 0 */
+static uint8_t ball [15*((15 + 1)/2)];
+/** Opaque */
+static uint8_t box [20*(20/2)];
+/** Odd width, transparent color 9 */
+static uint8_t bar [33*((33 + 1)/2)];
+
+static uint32_t Test_seed = 0x632BE5ABu;
+
+static uint32_t Test_random (uint32_t limit)
+{
+    Test_seed ^= Test_seed << 13;
+    Test_seed ^= Test_seed >> 17;
+    Test_seed ^= Test_seed << 5;
+    return Test_seed % limit;
+}
+
+static uint8_t Test_getPixel (const uint8_t* frame, uint8_t x, uint8_t y)
+{
+    uint8_t value = frame[(y * TEST_STRIDE) + (x/2)];
+    return (x%2) ? (value >> 4) : (value & 0x0F);
+}
+
+static void Test_setPixel (uint8_t* frame, uint8_t x, uint8_t y, uint8_t color)
+{
+    uint8_t* pixel = &frame[(y * TEST_STRIDE) + (x/2)];
+    if (x%2)
+        *pixel = (uint8_t)(color << 4) | (*pixel & 0x0F);
+    else
+        *pixel = (color & 0x0F) | (*pixel & 0xF0);
+}
+
+/**
+ * The function compose the reference pixel by pixel: the background and
+ * then every visible sprite, from the first one.
+ */
+static void Test_compose (void)
+{
+    for (uint8_t y = 0; y < TEST_HEIGHT; ++y)
+    {
+        for (uint8_t x = 0; x < TEST_WIDTH; ++x)
+        {
+            uint8_t color = (dev.background != 0) ? Test_getPixel(dev.background,x,y) : dev.backgroundColor;
+
+            for (uint8_t i = 0; i < WARCOMEB_SSD1327ZB_SPRITES; ++i)
+            {
+                const SSD1327ZB_Sprite* sprite = &dev.sprite[i];
+                int16_t sx = x - sprite->xPos;
+                int16_t sy = y - sprite->yPos;
+                if (!sprite->isVisible || (sprite->pixels == 0) ||
+                    (sx < 0) || (sy < 0) || (sx >= sprite->width) || (sy >= sprite->height))
+                    continue;
+
+                // Into the sprite the left pixel is the high nibble
+                uint8_t value = sprite->pixels[(sy * ((sprite->width + 1)/2)) + (sx/2)];
+                value = (sx%2) ? (value & 0x0F) : (value >> 4);
+                if (value != sprite->transparent) color = value;
+            }
+            Test_setPixel(reference,x,y,color);
+        }
+    }
+}
+
+/**
+ * The function check the buffer against the reference, and that every
+ * pixel changed since the last check is into a dirty area. Then the dirty
+ * areas are flushed and the panel is checked too.
+ *
+ * @return The number of errors.
+ */
+static uint32_t Test_check (const char* step)
+{
+    uint32_t errors = 0;
+
+    Test_compose();
+    for (uint8_t y = 0; y < TEST_HEIGHT; ++y)
+    {
+        for (uint8_t x = 0; x < TEST_WIDTH; ++x)
+        {
+            if (Test_getPixel(dev.buffer,x,y) != Test_getPixel(reference,x,y))
+            {
+                errors++;
+                continue;
+            }
+            if (Test_getPixel(before,x,y) == Test_getPixel(reference,x,y))
+                continue;
+
+            bool isDirty = FALSE;
+            for (uint8_t i = 0; i < dev.dirtyCount; ++i)
+            {
+                if ((x >= dev.dirty[i].xStart) && (x <= dev.dirty[i].xStop) &&
+                    (y >= dev.dirty[i].yStart) && (y <= dev.dirty[i].yStop))
+                    isDirty = TRUE;
+            }
+            if (!isDirty) errors++;
+        }
+    }
+
+    SSD1327ZB_flushDirty(&dev);
+    if (Test_comparePanel(&dev) != 0) errors++;
+    memcpy(before,dev.buffer,sizeof(before));
+
+    if (errors != 0)
+        printf("%s: %u errors\n",step,errors);
+    return errors;
+}
+
+/**
+ * @return The number of pixels into the dirty areas.
+ */
+static uint32_t Test_dirtyPixels (void)
+{
+    uint32_t pixels = 0;
+    for (uint8_t i = 0; i < dev.dirtyCount; ++i)
+    {
+        pixels += (uint32_t)(dev.dirty[i].xStop - dev.dirty[i].xStart + 1) *
+                  (dev.dirty[i].yStop - dev.dirty[i].yStart + 1);
+    }
+    return pixels;
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+    SSD1327ZB_flush(&dev);
+    memcpy(before,dev.buffer,sizeof(before));
+
+    for (uint16_t i = 0; i < sizeof(background); ++i)
+    {
+        background[i] = (uint8_t) Test_random(256);
+    }
+    for (uint16_t i = 0; i < sizeof(ball); ++i)
+    {
+        // A lot of transparent pixels
+        ball[i] = (Test_random(3) == 0) ? 0 : (uint8_t) Test_random(256);
+    }
+    for (uint16_t i = 0; i < sizeof(box); ++i)
+    {
+        box[i] = (uint8_t) Test_random(256);
+    }
+    for (uint16_t i = 0; i < sizeof(bar); ++i)
+    {
+        bar[i] = (Test_random(2) == 0) ? 0x99 : (uint8_t) Test_random(256);
+    }
+
+    // A plain background, then a picture
+    SSD1327ZB_setBackground(&dev,0,SSD1327ZB_GRAYSCALE_5);
+    TEST_CHECK(Test_check("plain background") == 0);
+    SSD1327ZB_setBackground(&dev,background,SSD1327ZB_GRAYSCALE_0);
+    TEST_CHECK(Test_check("background") == 0);
+
+    // Overlapping sprites: the box is over the ball, the bar over both
+    TEST_CHECK(SSD1327ZB_setSprite(&dev,0,ball,15,15,0) == GDL_ERRORS_OK);
+    TEST_CHECK(SSD1327ZB_setSprite(&dev,1,box,20,20,SSD1327ZB_SPRITE_OPAQUE) == GDL_ERRORS_OK);
+    TEST_CHECK(SSD1327ZB_setSprite(&dev,2,bar,33,9,9) == GDL_ERRORS_OK);
+    SSD1327ZB_moveSprite(&dev,0,21,30);
+    SSD1327ZB_moveSprite(&dev,1,30,35);
+    SSD1327ZB_moveSprite(&dev,2,17,40);
+    TEST_CHECK(Test_check("hidden sprites") == 0);
+    TEST_CHECK(dev.dirtyCount == 0);
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        SSD1327ZB_showSprite(&dev,i,TRUE);
+    }
+    TEST_CHECK(Test_check("shown sprites") == 0);
+
+    // A small move marks only the union of the two areas
+    SSD1327ZB_moveSprite(&dev,0,23,31);
+    TEST_CHECK(Test_dirtyPixels() <= (18 * 16));
+    TEST_CHECK(Test_check("small move") == 0);
+
+    // A long move marks the old and the new area
+    SSD1327ZB_moveSprite(&dev,1,90,95);
+    TEST_CHECK(dev.dirtyCount == 2);
+    TEST_CHECK(Test_dirtyPixels() <= (2 * 20 * 20));
+    TEST_CHECK(Test_check("long move") == 0);
+
+    // Out of the display on every side
+    SSD1327ZB_moveSprite(&dev,2,-10,-4);
+    TEST_CHECK(Test_check("top left") == 0);
+    SSD1327ZB_moveSprite(&dev,1,120,121);
+    TEST_CHECK(Test_check("bottom right") == 0);
+    SSD1327ZB_moveSprite(&dev,0,-20,60);
+    TEST_CHECK(Test_check("out of the display") == 0);
+    SSD1327ZB_moveSprite(&dev,0,40,50);
+    TEST_CHECK(Test_check("back into the display") == 0);
+
+    // Hide and show
+    SSD1327ZB_showSprite(&dev,2,FALSE);
+    TEST_CHECK(Test_check("hide") == 0);
+    SSD1327ZB_moveSprite(&dev,2,50,52);
+    TEST_CHECK(dev.dirtyCount == 0);
+    SSD1327ZB_showSprite(&dev,2,TRUE);
+    TEST_CHECK(Test_check("show") == 0);
+
+    // A new picture smaller than the old one
+    SSD1327ZB_setSprite(&dev,1,ball,15,15,0);
+    TEST_CHECK(Test_check("new picture") == 0);
+
+    // Random moves
+    for (uint16_t i = 0; i < 300; ++i)
+    {
+        uint8_t id = Test_random(3);
+        SSD1327ZB_moveSprite(&dev,id,(int16_t) Test_random(160) - 16,(int16_t) Test_random(160) - 16);
+        if (Test_random(8) == 0)
+            SSD1327ZB_showSprite(&dev,id,!dev.sprite[id].isVisible);
+        if (Test_check("random") != 0)
+        {
+            TEST_CHECK(FALSE);
+            break;
+        }
+    }
+
+    TEST_CHECK(SSD1327ZB_moveSprite(&dev,WARCOMEB_SSD1327ZB_SPRITES,0,0) == GDL_ERRORS_WRONG_VALUE);
+
+    return Test_end("sprites");
+}
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Statistics: the byte counters of the driver must match the command and
+ * data bytes seen on the mock bus, the flushes must be counted by kind
+ * and timed with the user clock, and the pixel counters must count the
+ * pixels written one by one.
+ */
+
+#include "test.h"
+
+static SSD1327ZB_Device dev;
+static uint32_t Test_clock = 0;
+
+/**
+ * Clock of the test: every read moves it by 10 units.
+ */
+static uint32_t Test_getTime (void)
+{
+    Test_clock += 10;
+    return Test_clock;
+}
+
+/**
+ * @return TRUE when the byte counters of the driver match the mock bus.
+ */
+static bool Test_matchBus (void)
+{
+    SSD1327ZB_Stats stats;
+    SSD1327ZB_getStats(&dev,&stats);
+    if ((stats.commandBytes != MockBus_counters.commandBytes) ||
+        (stats.dataBytes != MockBus_counters.dataBytes))
+    {
+        printf("stats: commands %u/%u data %u/%u\n",
+               stats.commandBytes,MockBus_counters.commandBytes,
+               stats.dataBytes,MockBus_counters.dataBytes);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+    dev.getTime = Test_getTime;
+    SSD1327ZB_resetStats(&dev);
+
+    SSD1327ZB_Stats stats;
+    SSD1327ZB_getStats(&dev,&stats);
+    TEST_CHECK((stats.commandBytes == 0) && (stats.dataBytes == 0) && (stats.flushes == 0));
+
+    // A full flush: one window and the whole frame
+    SSD1327ZB_flush(&dev);
+    TEST_CHECK(Test_matchBus());
+    SSD1327ZB_getStats(&dev,&stats);
+    TEST_CHECK(stats.dataBytes == WARCOMEB_SSD1327ZB_BUFFERDIMENSION);
+    TEST_CHECK(stats.commandBytes == 6);
+    TEST_CHECK(stats.flushes == 1);
+    TEST_CHECK((stats.flushTime == 10) && (stats.flushTimeMax == 10));
+
+    // Pixels written one by one, the second time with the same value
+    SSD1327ZB_drawPixel(&dev,3,4,SSD1327ZB_GRAYSCALE_7);
+    SSD1327ZB_drawPixel(&dev,3,4,SSD1327ZB_GRAYSCALE_7);
+    SSD1327ZB_drawPixel(&dev,200,4,SSD1327ZB_GRAYSCALE_7);
+    // The char is drawn through GDL: 6x8 pixels
+    SSD1327ZB_drawChar(&dev,10,20,'a',SSD1327ZB_GRAYSCALE_15,SSD1327ZB_GRAYSCALE_0,1);
+    // The lines write whole bytes and are not counted
+    SSD1327ZB_drawHLine(&dev,0,50,100,SSD1327ZB_GRAYSCALE_2);
+    SSD1327ZB_getStats(&dev,&stats);
+    TEST_CHECK(stats.pixels == (2 + (6*8)));
+    // The second pixel and the background of the char on a clear buffer
+    TEST_CHECK(stats.redundantPixels > 1);
+
+    // The dirty areas, the other flushes and the commands
+    SSD1327ZB_flushDirty(&dev);
+    TEST_CHECK(Test_matchBus());
+    SSD1327ZB_getStats(&dev,&stats);
+    TEST_CHECK(stats.flushParts == 3);
+
+    SSD1327ZB_drawRectangle(&dev,20,30,40,50,SSD1327ZB_GRAYSCALE_9,TRUE);
+    SSD1327ZB_flushDiff(&dev);
+    TEST_CHECK(Test_matchBus());
+
+    SSD1327ZB_drawRectangle(&dev,60,70,30,20,SSD1327ZB_GRAYSCALE_4,TRUE);
+    SSD1327ZB_flushBegin(&dev);
+    while (SSD1327ZB_flushStep(&dev,100)) {}
+    TEST_CHECK(Test_matchBus());
+
+    SSD1327ZB_setContrast(&dev,0x40);
+    SSD1327ZB_setLinearGrayTable(&dev);
+    TEST_CHECK(Test_matchBus());
+
+    SSD1327ZB_getStats(&dev,&stats);
+    TEST_CHECK(stats.flushes == 1);
+    TEST_CHECK(stats.flushDiffs == 1);
+    TEST_CHECK(stats.flushSteps > 1);
+    TEST_CHECK(stats.flushTimeMax == 10);
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    // The reset clears every counter
+    SSD1327ZB_resetStats(&dev);
+    SSD1327ZB_getStats(&dev,&stats);
+    TEST_CHECK((stats.commandBytes == 0) && (stats.pixels == 0) && (stats.flushTime == 0));
+
+    return Test_end("stats");
+}
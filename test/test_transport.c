@@ -0,0 +1,110 @@
+/******************************************************************************
+ * SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+ * Copyright (C) 2018 Alessio Socci & Marco Giammarini
+ *
+ * Authors:
+ *  Alessio Socci <alessios1284@hotmail.it>
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+
+/*
+ * Bus transports: the traffic recorded by the mock bus for a full frame
+ * and for the dirty areas, and the image received by the panel. The test
+ * is built once for every transport.
+ */
+
+#include "test.h"
+
+#if defined WARCOMEB_GDL_I2C
+#define TRANSPORT_NAME                         "i2c"
+#elif defined WARCOMEB_GDL_SPI
+#define TRANSPORT_NAME                         "spi"
+#else
+#define TRANSPORT_NAME                         "parallel"
+#endif
+
+static SSD1327ZB_Device dev;
+
+int main (void)
+{
+    memset(&dev,0,sizeof(dev));
+    Test_initDevice(&dev);
+    TEST_CHECK(MockBus_panel.isOn == 1);
+
+    // A full frame is a single transaction: window and pixels
+    for (uint16_t i = 0; i < WARCOMEB_SSD1327ZB_BUFFERDIMENSION; ++i)
+    {
+        dev.buffer[i] = (uint8_t)(i ^ (i >> 7));
+    }
+    SSD1327ZB_flush(&dev);
+    MockBus_Counters frame = MockBus_counters;
+    TEST_CHECK(frame.errors == 0);
+    TEST_CHECK(frame.transactions == 1);
+    TEST_CHECK(frame.commandBytes == 6);
+    TEST_CHECK(frame.dataBytes == WARCOMEB_SSD1327ZB_BUFFERDIMENSION);
+#if defined WARCOMEB_GDL_I2C
+    // Address, a control byte for every command and one for the data
+    TEST_CHECK(frame.framingBytes == 8);
+#else
+    TEST_CHECK(frame.csToggles == 2);
+#endif
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    printf("%s: full frame %u transactions, %u command bytes, %u data bytes, "
+           "%u framing bytes, %u CS edges\n",
+           TRANSPORT_NAME,frame.transactions,frame.commandBytes,frame.dataBytes,
+           frame.framingBytes,frame.csToggles);
+
+    // Every dirty area is a single transaction
+    MockBus_resetCounters();
+    SSD1327ZB_drawRectangle(&dev,3,5,20,7,SSD1327ZB_GRAYSCALE_9,TRUE);
+    SSD1327ZB_drawRectangle(&dev,100,90,9,30,SSD1327ZB_GRAYSCALE_4,TRUE);
+    SSD1327ZB_drawRectangle(&dev,60,0,1,1,SSD1327ZB_GRAYSCALE_15,TRUE);
+    uint8_t areas = dev.dirtyCount;
+    SSD1327ZB_flushDirty(&dev);
+    TEST_CHECK(areas == 3);
+    TEST_CHECK(MockBus_counters.errors == 0);
+    TEST_CHECK(MockBus_counters.transactions == areas);
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    // The same areas sent by the group flush of a single display
+    SSD1327ZB_Device* group[1] = {&dev};
+    MockBus_resetCounters();
+    SSD1327ZB_drawRectangle(&dev,3,5,20,7,SSD1327ZB_GRAYSCALE_2,TRUE);
+    SSD1327ZB_drawRectangle(&dev,100,90,9,30,SSD1327ZB_GRAYSCALE_3,TRUE);
+    SSD1327ZB_flushGroup(group,1);
+    TEST_CHECK(MockBus_counters.errors == 0);
+#if !defined WARCOMEB_GDL_I2C
+    TEST_CHECK(MockBus_counters.transactions == 1);
+#endif
+    TEST_CHECK(Test_comparePanel(&dev) == 0);
+
+    // Commands outside the flushes
+    MockBus_resetCounters();
+    SSD1327ZB_setContrast(&dev,0x35);
+    TEST_CHECK(MockBus_counters.errors == 0);
+    TEST_CHECK(MockBus_counters.transactions == 1);
+    TEST_CHECK(MockBus_panel.contrast == 0x35);
+
+    return Test_end("transport " TRANSPORT_NAME);
+}
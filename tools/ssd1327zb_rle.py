@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+# SSD1327ZB - Library for SSD1327ZB OLed Driver based on libohiboard
+# Copyright (C) 2018 Alessio Socci & Marco Giammarini
+#
+# Encoder of the compressed 4 bit pictures drawn by
+# SSD1327ZB_drawCompressedPicture and SSD1327ZB_sendCompressedPicture.
+# The format is described into ssd1327zb.h.
+#
+# PGM files (P2 and P5) are read directly, the other formats (PNG, BMP...)
+# need the Pillow package. The gray levels are scaled to 16 levels.
+#
+# Usage:
+#     ssd1327zb_rle.py [-o output.h] [-n name] picture...
+# The size of every picture and the compression ratio are printed on stderr.
+
+import argparse
+import os
+import re
+import sys
+
+LITERAL = 0x80
+LONG_RUN = 0x07
+MAX_SHORT_RUN = 7
+MAX_LONG_RUN = 255 + 8
+MAX_LITERAL_BYTES = 128
+# Shorter runs are cheaper inside a literal
+MIN_RUN = 4
+
+
+def read_pgm(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    # The header is made of four tokens, comments are allowed between them
+    tokens = []
+    pos = 0
+    while len(tokens) < 4:
+        match = re.compile(rb"\s*(#[^\n]*\n\s*)*(\S+)").match(data, pos)
+        if match is None:
+            raise ValueError("%s: wrong PGM header" % path)
+        tokens.append(match.group(2))
+        pos = match.end()
+
+    magic, width, height, maxval = tokens[0], int(tokens[1]), int(tokens[2]), int(tokens[3])
+    if magic == b"P5":
+        pos += 1
+        size = 2 if maxval > 255 else 1
+        raw = data[pos:pos + width * height * size]
+        if size == 2:
+            values = [(raw[i] << 8) | raw[i + 1] for i in range(0, len(raw), 2)]
+        else:
+            values = list(raw)
+    elif magic == b"P2":
+        values = [int(v) for v in data[pos:].split()]
+    else:
+        raise ValueError("%s: only P2 and P5 files are supported" % path)
+
+    if len(values) < width * height:
+        raise ValueError("%s: truncated file" % path)
+    return width, height, maxval, values[:width * height]
+
+
+def read_image(path):
+    if path.lower().endswith(".pgm"):
+        return read_pgm(path)
+
+    try:
+        from PIL import Image
+    except ImportError:
+        raise ValueError("%s: Pillow is needed for this format" % path)
+    image = Image.open(path).convert("L")
+    return image.width, image.height, 255, list(image.getdata())
+
+
+def to_levels(maxval, values):
+    return [(v * 15 + maxval // 2) // maxval for v in values]
+
+
+def run_length(pixels, start):
+    end = start + 1
+    while end < len(pixels) and pixels[end] == pixels[start] and (end - start) < MAX_LONG_RUN:
+        end += 1
+    return end - start
+
+
+def encode(pixels):
+    out = bytearray()
+    literal = bytearray()
+
+    def close_literal():
+        if literal:
+            out.append(LITERAL | (len(literal) - 1))
+            out.extend(literal)
+            literal.clear()
+
+    i = 0
+    while i < len(pixels):
+        run = run_length(pixels, i)
+        # A literal needs two pixels, the last one is a run
+        if run >= MIN_RUN or (i + 1) == len(pixels):
+            close_literal()
+            if run <= MAX_SHORT_RUN:
+                out.append((pixels[i] << 3) | (run - 1))
+            else:
+                out.append((pixels[i] << 3) | LONG_RUN)
+                out.append(run - 8)
+            i += run
+        else:
+            literal.append(pixels[i] | (pixels[i + 1] << 4))
+            if len(literal) == MAX_LITERAL_BYTES:
+                close_literal()
+            i += 2
+    close_literal()
+    return bytes(out)
+
+
+def decode(data, count):
+    # Reference decoder, used to check the encoder
+    pixels = []
+    pos = 0
+    while len(pixels) < count:
+        header = data[pos]
+        pos += 1
+        if header & LITERAL:
+            for value in data[pos:pos + (header & 0x7F) + 1]:
+                pixels.extend((value & 0x0F, value >> 4))
+            pos += (header & 0x7F) + 1
+        else:
+            run = (header & LONG_RUN) + 1
+            if (header & LONG_RUN) == LONG_RUN:
+                run = data[pos] + 8
+                pos += 1
+            pixels.extend([header >> 3] * run)
+    return pixels[:count]
+
+
+def c_name(path):
+    name = os.path.splitext(os.path.basename(path))[0]
+    return re.sub(r"\W", "_", name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compress pictures for the SSD1327ZB driver")
+    parser.add_argument("pictures", nargs="+")
+    parser.add_argument("-o", "--output", help="output file, stdout if missing")
+    parser.add_argument("-n", "--name", help="name of the array, only with one picture")
+    args = parser.parse_args()
+
+    lines = ["/* Generated by ssd1327zb_rle.py */", "", "#include <stdint.h>", ""]
+    total_raw = 0
+    total_packed = 0
+
+    for path in args.pictures:
+        try:
+            width, height, maxval, values = read_image(path)
+        except (OSError, ValueError) as error:
+            sys.exit(str(error))
+
+        pixels = to_levels(maxval, values)
+        packed = encode(pixels)
+        assert decode(packed, len(pixels)) == pixels
+
+        name = args.name if (args.name and len(args.pictures) == 1) else c_name(path)
+        raw = ((width + 1) // 2) * height
+        total_raw += raw
+        total_packed += len(packed)
+        sys.stderr.write("%s: %dx%d, %d bytes instead of %d (%.1f:1)\n"
+                         % (path, width, height, len(packed), raw, raw / len(packed)))
+
+        lines.append("#define %s_WIDTH %d" % (name.upper(), width))
+        lines.append("#define %s_HEIGHT %d" % (name.upper(), height))
+        lines.append("const uint8_t %s[%d] =" % (name, len(packed)))
+        lines.append("{")
+        for i in range(0, len(packed), 12):
+            lines.append("    " + " ".join("0x%02X," % b for b in packed[i:i + 12]))
+        lines.append("};")
+        lines.append("")
+
+    if len(args.pictures) > 1:
+        sys.stderr.write("total: %d bytes instead of %d (%.1f:1)\n"
+                         % (total_packed, total_raw, total_raw / total_packed))
+
+    text = "\n".join(lines)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()